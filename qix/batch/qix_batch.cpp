@@ -0,0 +1,235 @@
+#include "game/autoplayer.h"
+#include "game/playfield.h"
+#include "utility/job_system.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// Plays many games headless, each seeding its Qix and autoplayer differently, spread over every core.
+// Every game owns its playfield, autoplayer and result, so games share no mutable state and
+// total ticks per second grows with the cores. A game ends when the target is claimed, when
+// the player is out of lives or after --max-ticks. Prints a summary and optionally writes
+// every game to a CSV file and a summary with every game to a JSON file.
+//
+// qix_batch [--games n] [--seed n] [--workers n] [--max-ticks n] [--target percent]
+//           [--lives n] [--step-ticks n] [--csv file] [--json file]
+
+namespace {
+
+using HighResClock = std::chrono::high_resolution_clock;
+
+const double kLogicTick = 1.0 / kLogicTicksPerSecond; // seconds
+
+struct Settings {
+  size_t games = 1000;
+  uint64_t seed = 1981;
+  size_t workers = 0;
+  int64_t max_ticks = 5 * 60 * kLogicTicksPerSecond;
+  double target = 75.0;
+  int lives = 3;
+  int step_ticks = 2;
+  std::string csv;
+  std::string json;
+};
+
+enum class Outcome { Claimed, OutOfLives, Timeout };
+
+struct Result {
+  uint64_t seed = 0;
+  Outcome outcome = Outcome::Timeout;
+  double claimed = 0.0;
+  int deaths = 0;
+  int64_t ticks = 0;
+  double seconds = 0.0;
+};
+
+const char* ToString(Outcome outcome) {
+  switch (outcome) {
+    case Outcome::Claimed:
+      return "claimed";
+    case Outcome::OutOfLives:
+      return "out_of_lives";
+    default:
+      return "timeout";
+  }
+}
+
+void Apply(Playfield& playfield, Playfield::Controls control) {
+  if (Playfield::Controls::None != control) {
+    playfield.GameControl(control);
+  }
+}
+
+Result Play(const Settings& settings, uint64_t seed) {
+  const auto start = HighResClock::now();
+  Playfield playfield(Playfield::Backend::Null);
+  Autoplayer autoplayer(seed, settings.step_ticks);
+  Result result;
+
+  result.seed = seed;
+  playfield.SetSeed(seed);
+  playfield.NewGame();
+  for (; result.ticks < settings.max_ticks; ++result.ticks) {
+    Apply(playfield, autoplayer.Next(playfield));
+    playfield.Update(kLogicTick);
+    if (playfield.ClaimedPercentage() >= settings.target) {
+      result.outcome = Outcome::Claimed;
+      break;
+    }
+    if (playfield.deaths() >= settings.lives) {
+      result.outcome = Outcome::OutOfLives;
+      break;
+    }
+  }
+  result.claimed = playfield.ClaimedPercentage();
+  result.deaths = playfield.deaths();
+  result.seconds = std::chrono::duration<double>(HighResClock::now() - start).count();
+
+  return result;
+}
+
+void WriteCsv(const std::string& filename, const std::vector<Result>& results) {
+  std::ofstream file(filename);
+
+  file << "seed,outcome,claimed,deaths,ticks,ticks_per_second" << std::endl;
+  for (const auto& result : results) {
+    file << result.seed << "," << ToString(result.outcome) << "," << std::fixed << std::setprecision(2)
+         << result.claimed << "," << result.deaths << "," << result.ticks << "," << std::setprecision(0)
+         << result.ticks / result.seconds << std::endl;
+  }
+}
+
+struct Summary {
+  size_t games = 0;
+  size_t claimed_games = 0;
+  double claimed = 0.0;
+  double deaths = 0.0;
+  double ticks = 0.0;
+  int64_t total_ticks = 0;
+  double ticks_per_second = 0.0;
+  double seconds = 0.0;
+};
+
+Summary Summarize(const std::vector<Result>& results, double seconds) {
+  Summary summary;
+
+  summary.games = results.size();
+  summary.seconds = seconds;
+  for (const auto& result : results) {
+    summary.claimed_games += (Outcome::Claimed == result.outcome) ? 1 : 0;
+    summary.claimed += result.claimed;
+    summary.deaths += result.deaths;
+    summary.total_ticks += result.ticks;
+  }
+  if (!results.empty()) {
+    summary.claimed /= results.size();
+    summary.deaths /= results.size();
+    summary.ticks = static_cast<double>(summary.total_ticks) / results.size();
+  }
+  summary.ticks_per_second = summary.total_ticks / seconds;
+
+  return summary;
+}
+
+void WriteJson(const std::string& filename, const Summary& summary, const std::vector<Result>& results) {
+  std::ofstream file(filename);
+
+  file << std::fixed << std::setprecision(2) << "{\n"
+       << "  \"games\": " << summary.games << ",\n"
+       << "  \"claimed_games\": " << summary.claimed_games << ",\n"
+       << "  \"mean_claimed\": " << summary.claimed << ",\n"
+       << "  \"mean_deaths\": " << summary.deaths << ",\n"
+       << "  \"mean_ticks\": " << summary.ticks << ",\n"
+       << "  \"total_ticks\": " << summary.total_ticks << ",\n"
+       << "  \"seconds\": " << summary.seconds << ",\n"
+       << "  \"ticks_per_second\": " << std::setprecision(0) << summary.ticks_per_second << ",\n"
+       << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto& result = results[i];
+
+    file << ((0 == i) ? "\n" : ",\n") << "    { \"seed\": " << result.seed << ", \"outcome\": \""
+         << ToString(result.outcome) << "\", \"claimed\": " << std::setprecision(2) << result.claimed
+         << ", \"deaths\": " << result.deaths << ", \"ticks\": " << result.ticks << " }";
+  }
+  file << "\n  ]\n}" << std::endl;
+}
+
+bool ParseArguments(int argc, char *argv[], Settings& settings) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const std::string value = argv[++i];
+
+    if ("--games" == arg) {
+      settings.games = std::stoull(value);
+    } else if ("--seed" == arg) {
+      settings.seed = std::stoull(value);
+    } else if ("--workers" == arg) {
+      settings.workers = std::stoull(value);
+    } else if ("--max-ticks" == arg) {
+      settings.max_ticks = std::stoll(value);
+    } else if ("--target" == arg) {
+      settings.target = std::stod(value);
+    } else if ("--lives" == arg) {
+      settings.lives = std::stoi(value);
+    } else if ("--step-ticks" == arg) {
+      settings.step_ticks = std::max(std::stoi(value), 1);
+    } else if ("--csv" == arg) {
+      settings.csv = value;
+    } else if ("--json" == arg) {
+      settings.json = value;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  Settings settings;
+
+  if (!ParseArguments(argc, argv, settings)) {
+    std::cout << "usage: qix_batch [--games n] [--seed n] [--workers n] [--max-ticks n] [--target percent]"
+              << " [--lives n] [--step-ticks n] [--csv file] [--json file]" << std::endl;
+    return -1;
+  }
+  utility::JobSystem jobs(settings.workers);
+  std::vector<Result> results(settings.games);
+  auto play = [&settings, &results](size_t first, size_t last) {
+    for (auto i = first; i < last; ++i) {
+      results[i] = Play(settings, settings.seed + i);
+    }
+  };
+  const auto start = HighResClock::now();
+
+  jobs.ParallelFor(0, results.size(), 1, play);
+
+  const auto summary = Summarize(results, std::chrono::duration<double>(HighResClock::now() - start).count());
+
+  std::cout << "workers: " << jobs.size() << std::endl;
+  std::cout << "games: " << summary.games << " (" << summary.claimed_games << " reached "
+            << settings.target << "%)" << std::endl;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "mean claimed: " << summary.claimed << "%" << std::endl;
+  std::cout << "mean deaths: " << summary.deaths << std::endl;
+  std::cout << "mean ticks: " << std::setprecision(0) << summary.ticks << std::endl;
+  std::cout << "seconds: " << std::setprecision(3) << summary.seconds << std::endl;
+  std::cout << "ticks/s: " << std::setprecision(0) << summary.ticks_per_second << std::endl;
+  if (!settings.csv.empty()) {
+    WriteCsv(settings.csv, results);
+  }
+  if (!settings.json.empty()) {
+    WriteJson(settings.json, summary, results);
+  }
+
+  return 0;
+}
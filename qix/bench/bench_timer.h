@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+
+namespace bench {
+
+using HighResClock = std::chrono::high_resolution_clock;
+
+// Long enough for the clock resolution and a cold cache not to show in the numbers
+constexpr double kMinimumRunTime = 0.25; // seconds
+
+// Calls function until kMinimumRunTime has passed, returns the calls per second
+template<typename Function>
+double Measure(Function function) {
+  const auto start = HighResClock::now();
+  std::chrono::duration<double> elapsed{};
+  size_t runs = 0;
+
+  do {
+    function();
+    runs++;
+    elapsed = HighResClock::now() - start;
+  } while (elapsed.count() < kMinimumRunTime);
+
+  return runs / elapsed.count();
+}
+
+}  // namespace bench
@@ -0,0 +1,106 @@
+#include "catch.hpp"
+#include "bench_timer.h"
+#include "game/constants.h"
+#include "game/collision.h"
+
+#include <random>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+using Segment = SegmentGrid::Segment;
+
+const int kQixLines = 7;
+
+// A stix like trail of unit steps, turning every now and then
+std::vector<Segment> CreateTrail(int length) {
+  std::mt19937 rng(1981);
+  std::vector<Segment> trail;
+  int x = kPlayFieldWidth / 2;
+  int y = kPlayFieldHeight - 1;
+  int dx = 0;
+  int dy = -1;
+
+  for (int i = 0; i < length; ++i) {
+    if (0 == rng() % 40) {
+      std::tie(dx, dy) = std::make_pair(dy, dx);
+      if (rng() % 2) {
+        dx = -dx;
+        dy = -dy;
+      }
+    }
+    const int nx = std::clamp(x + dx, 0, kPlayFieldWidth - 1);
+    const int ny = std::clamp(y + dy, 0, kPlayFieldHeight - 1);
+
+    trail.push_back({ static_cast<float>(x), static_cast<float>(y), static_cast<float>(nx), static_cast<float>(ny) });
+    x = nx;
+    y = ny;
+  }
+  return trail;
+}
+
+// Qix sized lines scattered over the field, one set of kQixLines per simulated tick
+std::vector<Segment> CreateLines(int count) {
+  std::mt19937 rng(2021);
+  std::uniform_real_distribution<float> position(0.0f, kPlayFieldWidth);
+  std::uniform_real_distribution<float> offset(-70.0f, 70.0f);
+  std::vector<Segment> lines;
+
+  for (int i = 0; i < count; ++i) {
+    const float x = position(rng);
+    const float y = position(rng);
+
+    lines.push_back({ x, y, x + offset(rng), y + offset(rng) });
+  }
+  return lines;
+}
+
+// Ticks per second, kQixLines queries per tick
+template<typename Function>
+double Measure(const std::vector<Segment>& lines, Function intersects) {
+  size_t hits = 0;
+  const double rate = bench::Measure([&lines, &intersects, &hits] {
+    for (const auto& line : lines) {
+      hits += intersects(line) ? 1 : 0;
+    }
+  });
+
+  REQUIRE(hits > 0);
+
+  return rate * (lines.size() / kQixLines);
+}
+
+}  // namespace
+
+TEST_CASE("Spatial hash against naive pairwise trail tests", "[collision]") {
+  const auto lines = CreateLines(kQixLines * 1000);
+
+  std::cout << std::left << std::setw(10) << "trail" << std::setw(16) << "naive ticks/s" << "grid ticks/s" << std::endl;
+  for (int length : { 100, 500, 2000, 8000 }) {
+    const auto trail = CreateTrail(length);
+    SegmentGrid grid(kPlayFieldWidth, kPlayFieldHeight, Collision::kCellSize);
+
+    for (const auto& s : trail) {
+      grid.Add(s);
+    }
+    auto naive_intersects = [&trail](const Segment& line) {
+      for (const auto& s : trail) {
+        if (SegmentsIntersect(s, line)) {
+          return true;
+        }
+      }
+      return false;
+    };
+    auto grid_intersects = [&grid](const Segment& line) { return grid.Intersects(line); };
+
+    for (const auto& line : lines) {
+      REQUIRE(naive_intersects(line) == grid_intersects(line));
+    }
+    const auto naive = Measure(lines, naive_intersects);
+    const auto hashed = Measure(lines, grid_intersects);
+
+    std::cout << std::left << std::setw(10) << length << std::setw(16) << static_cast<size_t>(naive)
+              << static_cast<size_t>(hashed) << std::endl;
+  }
+}
@@ -0,0 +1,83 @@
+#include "catch.hpp"
+#include "bench_timer.h"
+#include "game/constants.h"
+#include "game/flood_fill.h"
+
+#include <random>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+using bench::HighResClock;
+
+const int kQixX = kPlayFieldWidth / 2;
+const int kQixY = kPlayFieldHeight / 2;
+
+// Scatters small claimed rectangles over the board, every rectangle splits the rows it
+// covers into one more span. The cell holding the Qix is always left unclaimed.
+Grid CreateBoard(int rectangles) {
+  Grid grid(kPlayFieldWidth, kPlayFieldHeight);
+  std::mt19937 rng(1981);
+  std::uniform_int_distribution<int> size(2, 12);
+  std::uniform_int_distribution<int> x_pos(1, kPlayFieldWidth - 14);
+  std::uniform_int_distribution<int> y_pos(1, kPlayFieldHeight - 14);
+
+  for (int i = 0; i < rectangles; ++i) {
+    const SDL_Rect rc = { x_pos(rng), y_pos(rng), size(rng), size(rng) };
+
+    if (kQixX >= rc.x && kQixX < rc.x + rc.w && kQixY >= rc.y && kQixY < rc.y + rc.h) {
+      continue;
+    }
+    for (int y = rc.y; y < rc.y + rc.h; ++y) {
+      for (int x = rc.x; x < rc.x + rc.w; ++x) {
+        grid.Set(x, y, Grid::Cell::Claimed);
+      }
+    }
+  }
+  return grid;
+}
+
+}  // namespace
+
+TEST_CASE("Flood fill throughput at increasing fragmentation", "[flood_fill]") {
+  const std::vector<std::pair<std::string, int>> kLevels = {
+    { "none", 0 }, { "low", 100 }, { "medium", 1000 }, { "high", 10000 }, { "extreme", 40000 }
+  };
+  FloodFill flood_fill(kPlayFieldWidth, kPlayFieldHeight);
+
+  std::cout << std::left << std::setw(12) << "fragments" << std::setw(14) << "cells filled" << "fills/s" << std::endl;
+  for (const auto& [name, rectangles] : kLevels) {
+    const auto grid = CreateBoard(rectangles);
+    size_t cells = 0;
+    const double rate = bench::Measure([&flood_fill, &grid, &cells] { cells = flood_fill.Fill(grid, kQixX, kQixY); });
+
+    REQUIRE(cells > 0);
+    std::cout << std::left << std::setw(12) << name << std::setw(14) << cells << static_cast<size_t>(rate) << std::endl;
+  }
+}
+
+TEST_CASE("Worst case full board claim against a frame", "[flood_fill]") {
+  const double kFrameTime = 16.0; // milliseconds
+
+  // A stix right next to the left border, the Qix side is the whole board
+  auto board = CreateBoard(10000);
+
+  for (int y = 1; y < kPlayFieldHeight - 1; ++y) {
+    board.Set(2, y, Grid::Cell::Edge);
+  }
+  FloodFill flood_fill(kPlayFieldWidth, kPlayFieldHeight);
+  double worst = 0.0;
+
+  for (int i = 0; i < 50; ++i) {
+    auto grid = board;
+    const auto start = HighResClock::now();
+
+    REQUIRE(flood_fill.Claim(grid, kQixX, kQixY) > 0);
+
+    const std::chrono::duration<double, std::milli> elapsed = HighResClock::now() - start;
+
+    worst = std::max(worst, elapsed.count());
+  }
+  std::cout << "Worst case claim: " << worst << " ms of a " << kFrameTime << " ms frame" << std::endl;
+}
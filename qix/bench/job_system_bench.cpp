@@ -0,0 +1,94 @@
+#include "catch.hpp"
+#include "bench_timer.h"
+#include "game/constants.h"
+#include "game/flood_fill.h"
+#include "utility/rasterizer.h"
+#include "utility/job_system.h"
+
+#include <random>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+using namespace utility;
+using bench::Measure;
+
+const std::vector<size_t> kWorkers = { 1, 2, 4, 8 };
+const size_t kBoards = 32;
+
+const std::array<Rasterizer::Pattern, 4> kPatterns = {{
+  { 0x000000ff }, { 0x0000f0ff, 0xb6c3c9ff, 8 }, { 0xffffffff }, { 0xf00000ff }
+}};
+
+Grid CreateBoard(uint32_t seed) {
+  Grid grid(kPlayFieldWidth, kPlayFieldHeight);
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> size(2, 12);
+  std::uniform_int_distribution<int> x_pos(1, kPlayFieldWidth - 14);
+  std::uniform_int_distribution<int> y_pos(1, kPlayFieldHeight - 14);
+
+  for (int i = 0; i < 1000; ++i) {
+    const SDL_Rect rc = { x_pos(rng), y_pos(rng), size(rng), size(rng) };
+
+    for (int y = rc.y; y < rc.y + rc.h; ++y) {
+      for (int x = rc.x; x < rc.x + rc.w; ++x) {
+        grid.Set(x, y, Grid::Cell::Claimed);
+      }
+    }
+  }
+  grid.Set(kPlayFieldWidth / 2, kPlayFieldHeight / 2, Grid::Cell::Unclaimed);
+
+  return grid;
+}
+
+void PrintRow(size_t workers, double rate, double base) {
+  std::cout << std::left << std::setw(10) << workers << std::setw(14) << static_cast<size_t>(rate)
+            << std::fixed << std::setprecision(2) << rate / base << "x" << std::endl;
+}
+
+}  // namespace
+
+TEST_CASE("Flood fills of independent boards scale with workers", "[job_system]") {
+  std::vector<Grid> boards;
+  std::vector<std::unique_ptr<FloodFill>> fills;
+
+  for (size_t i = 0; i < kBoards; ++i) {
+    boards.emplace_back(CreateBoard(static_cast<uint32_t>(1981 + i)));
+    fills.emplace_back(std::make_unique<FloodFill>(kPlayFieldWidth, kPlayFieldHeight));
+  }
+  double base = 0.0;
+
+  std::cout << std::left << std::setw(10) << "workers" << std::setw(14) << "fills/s" << "speedup" << std::endl;
+  for (auto workers : kWorkers) {
+    JobSystem jobs(workers);
+    auto fill = [&boards, &fills](size_t first, size_t last) {
+      for (auto i = first; i < last; ++i) {
+        fills[i]->Fill(boards[i], kPlayFieldWidth / 2, kPlayFieldHeight / 2);
+      }
+    };
+    const double rate = kBoards * Measure([&jobs, &fill] { jobs.ParallelFor(0, kBoards, 1, fill); });
+
+    base = (0.0 == base) ? rate : base;
+    PrintRow(workers, rate, base);
+  }
+}
+
+TEST_CASE("Rasterizing the playfield scales with workers", "[job_system]") {
+  const auto board = CreateBoard(1981);
+  std::vector<SDL_Rect> rows;
+  double base = 0.0;
+
+  board.ForEachDirtySpan([&rows](const SDL_Rect& rc) { rows.push_back(rc); });
+  std::cout << std::left << std::setw(10) << "workers" << std::setw(14) << "frames/s" << "speedup" << std::endl;
+  for (auto workers : kWorkers) {
+    JobSystem jobs(workers);
+    Rasterizer rasterizer(kPlayFieldWidth, kPlayFieldHeight, kPatterns, jobs);
+    const double rate = Measure([&rasterizer, &board, &rows] {
+      rasterizer.Render(board.row(0), board.words_per_row(), rows);
+    });
+
+    base = (0.0 == base) ? rate : base;
+    PrintRow(workers, rate, base);
+  }
+}
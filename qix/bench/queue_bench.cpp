@@ -0,0 +1,87 @@
+#include "catch.hpp"
+#include "bench_timer.h"
+#include "utility/spsc_queue.h"
+#include "utility/threadsafe_queue.h"
+
+#include <thread>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+using bench::HighResClock;
+
+const int64_t kCount = 5000000;
+
+// Items per second handed from one producer thread to one consumer thread. Both sides yield
+// instead of spinning when the SPSC queue is full or empty, so the numbers make sense on a single core too.
+// One run of kCount items is long enough on its own, it is timed once instead of with bench::Measure.
+template<typename Push, typename Consume>
+double MeasureHandoff(Push push, Consume consume) {
+  const auto start = HighResClock::now();
+  int64_t sum = 0;
+  std::thread consumer([&consume, &sum]() { sum = consume(); });
+
+  for (int64_t i = 0; i < kCount; ++i) {
+    push(i);
+  }
+  consumer.join();
+
+  const std::chrono::duration<double> elapsed = HighResClock::now() - start;
+
+  REQUIRE(kCount * (kCount - 1) / 2 == sum);
+
+  return kCount / elapsed.count();
+}
+
+}  // namespace
+
+TEST_CASE("SPSC queue throughput against ThreadSafeQueue", "[queue]") {
+  ThreadSafeQueue<int64_t> locked;
+  auto spsc = std::make_unique<utility::SpscQueue<int64_t, 4096>>();
+
+  const auto locked_rate = MeasureHandoff([&locked](int64_t i) { locked.Push(i); },
+                                          [&locked]() {
+                                            int64_t sum = 0;
+
+                                            for (int64_t i = 0; i < kCount; ++i) {
+                                              sum += locked.Pop();
+                                            }
+                                            return sum;
+                                          });
+  const auto spsc_rate = MeasureHandoff([&spsc](int64_t i) { while (!spsc->TryPush(i)) { std::this_thread::yield(); } },
+                                        [&spsc]() {
+                                          int64_t sum = 0;
+                                          int64_t count = 0;
+                                          int64_t value;
+
+                                          while (count < kCount) {
+                                            if (spsc->TryPop(value)) {
+                                              sum += value;
+                                              count++;
+                                            } else {
+                                              std::this_thread::yield();
+                                            }
+                                          }
+                                          return sum;
+                                        });
+  const auto drain_rate = MeasureHandoff([&spsc](int64_t i) { while (!spsc->TryPush(i)) { std::this_thread::yield(); } },
+                                         [&spsc]() {
+                                           int64_t sum = 0;
+                                           int64_t count = 0;
+
+                                           while (count < kCount) {
+                                             const auto drained = spsc->Drain([&sum](int64_t value) { sum += value; });
+
+                                      if (0 == drained) {
+                                        std::this_thread::yield();
+                                      }
+                                      count += drained;
+                                    }
+                                    return sum;
+                                  });
+
+  std::cout << std::left << std::setw(24) << "ThreadSafeQueue" << static_cast<size_t>(locked_rate) << " items/s" << std::endl;
+  std::cout << std::left << std::setw(24) << "SpscQueue TryPop" << static_cast<size_t>(spsc_rate) << " items/s" << std::endl;
+  std::cout << std::left << std::setw(24) << "SpscQueue Drain" << static_cast<size_t>(drain_rate) << " items/s" << std::endl;
+}
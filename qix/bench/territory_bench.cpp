@@ -0,0 +1,83 @@
+#include "catch.hpp"
+#include "bench_timer.h"
+#include "game/territory.h"
+#include "game/flood_fill.h"
+
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+using bench::Measure;
+
+const int kBoxes = 40;
+
+struct Box {
+  SDL_Point start;
+  std::vector<SDL_Point> corners;
+  SDL_Point end;
+};
+
+// Boxes hanging from the top edge side by side, scaled to the size of the field. Every box
+// has the same corners whatever the size.
+std::vector<Box> CreateBoxes(int size) {
+  const int width = (size - 2) / (2 * kBoxes);
+  const int depth = size / 4;
+  std::vector<Box> boxes;
+
+  for (int i = 0; i < kBoxes; ++i) {
+    const int x = 1 + 2 * i * width;
+
+    boxes.push_back({ { x, 0 }, { { x, 1 }, { x, depth }, { x + width, depth }, { x + width, 1 } },
+                      { x + width, 0 } });
+  }
+  return boxes;
+}
+
+}  // namespace
+
+TEST_CASE("Vector claims cost the same at any size, bitmap claims grow with the area", "[territory]") {
+  const std::vector<int> kSizes = { 800, 3200, 1 << 16, 1 << 30 };
+  const int kMaxBitmapSize = 3200;
+
+  std::cout << std::left << std::setw(14) << "size" << std::setw(16) << "vector/s" << "bitmap/s" << std::endl;
+  for (auto size : kSizes) {
+    const auto boxes = CreateBoxes(size);
+    const SDL_Point qix = { size / 2, size - 2 };
+    Territory territory(size, size);
+    // Every run claims all the boxes
+    const double vector = kBoxes * Measure([&territory, &boxes, qix] {
+      territory.Reset();
+      for (const auto& box : boxes) {
+        territory.Claim(box.start, box.corners, box.end, qix);
+      }
+    });
+
+    REQUIRE(territory.claimed().size() == kBoxes);
+    std::cout << std::left << std::setw(14) << size << std::setw(16) << static_cast<size_t>(vector);
+    if (size > kMaxBitmapSize) {
+      std::cout << "-" << std::endl;
+      continue;
+    }
+    Grid grid(size, size);
+    FloodFill flood_fill(size, size);
+    const double bitmap = kBoxes * Measure([&grid, &flood_fill, &boxes, qix] {
+      grid.Reset();
+      for (const auto& box : boxes) {
+        // Each side of the box, cell by cell
+        SDL_Point pt = box.start;
+
+        for (const auto& corner : box.corners) {
+          while (pt.x != corner.x || pt.y != corner.y) {
+            pt.x += (corner.x > pt.x) - (corner.x < pt.x);
+            pt.y += (corner.y > pt.y) - (corner.y < pt.y);
+            grid.Set(pt.x, pt.y, Grid::Cell::Edge);
+          }
+        }
+        flood_fill.Claim(grid, qix.x, qix.y);
+      }
+    });
+
+    std::cout << static_cast<size_t>(bitmap) << std::endl;
+  }
+}
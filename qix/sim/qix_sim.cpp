@@ -0,0 +1,209 @@
+#include "game/playfield.h"
+#include "game/replay.h"
+#include "utility/alloc_counter.h"
+
+#include <map>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// Runs the playfield logic as fast as the CPU allows, without a window or a GPU, and reports
+// ticks per second. Input comes from a script, one "<tick> <control>" pair per line, which is
+// replayed from the start when it runs out. A replay recorded by qix can be used instead of a
+// script, it then runs once unless --ticks says otherwise, and --record writes the controls
+// applied during the run as a replay.
+//
+// qix_sim [--ticks n] [--backend null|software] [--script file | --replay file] [--record file]
+
+namespace {
+
+using HighResClock = std::chrono::high_resolution_clock;
+using Controls = Playfield::Controls;
+
+const int64_t kDefaultTicks = 1000000;
+const double kLogicTick = 1.0 / kLogicTicksPerSecond; // seconds
+
+const std::map<std::string, Controls> kControlNames = {
+  { "Left", Controls::Left }, { "Right", Controls::Right }, { "Up", Controls::Up }, { "Down", Controls::Down },
+  { "Start", Controls::Start }, { "Pause", Controls::Pause }, { "Slow", Controls::Slow }, { "Fast", Controls::Fast }
+};
+
+struct Input {
+  int64_t tick;
+  Controls control;
+};
+
+using Script = std::vector<Input>;
+
+// Draws boxes up from the bottom border, walking to the left, one step every fourth tick
+Script CreateDefaultScript() {
+  const int kStepTicks = 4;
+  const std::vector<std::pair<int, int>> kBoxes = { { 40, 30 }, { 80, 120 }, { 20, 300 }, { 150, 60 }, { 60, 200 } };
+  Script script;
+  int64_t tick = 0;
+
+  auto steps = [&script, &tick](Controls control, int count) {
+    for (int i = 0; i < count; ++i) {
+      script.push_back({ tick, control });
+      tick += kStepTicks;
+    }
+  };
+  script.push_back({ tick++, Controls::Start });
+  for (const auto& [width, height] : kBoxes) {
+    steps(Controls::Up, height);
+    steps(Controls::Left, width);
+    steps(Controls::Down, height);
+    steps(Controls::Left, 10);
+  }
+  return script;
+}
+
+Script LoadScript(const std::string& filename) {
+  std::ifstream file(filename);
+
+  if (!file) {
+    std::cout << "Failed to open script : " << filename << std::endl;
+    exit(-1);
+  }
+  Script script;
+  std::string line;
+
+  while (std::getline(file, line)) {
+    if (line.empty() || '#' == line[0]) {
+      continue;
+    }
+    std::istringstream ss(line);
+    int64_t tick;
+    std::string name;
+
+    if (!(ss >> tick >> name) || 0 == kControlNames.count(name) || (!script.empty() && tick < script.back().tick)) {
+      std::cout << "Invalid script line : " << line << std::endl;
+      exit(-1);
+    }
+    script.push_back({ tick, kControlNames.at(name) });
+  }
+  if (script.empty()) {
+    std::cout << "Empty script : " << filename << std::endl;
+    exit(-1);
+  }
+  return script;
+}
+
+void Apply(Playfield& playfield, Controls control) {
+  switch (control) {
+    case Controls::Start:
+      playfield.NewGame();
+      break;
+    case Controls::Pause:
+      playfield.Pause();
+      break;
+    default:
+      playfield.GameControl(control);
+      break;
+  }
+}
+
+Script LoadReplay(const std::string& filename, uint64_t& seed) {
+  ReplayPlayer player(filename);
+  Script script;
+
+  seed = player.seed();
+  for (const auto& record : player.records()) {
+    script.push_back({ record.tick, record.control });
+  }
+  if (script.empty()) {
+    std::cout << "Empty replay : " << filename << std::endl;
+    exit(-1);
+  }
+  return script;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  int64_t ticks = 0;
+  auto backend = Playfield::Backend::Null;
+  Script script;
+  bool is_replay = false;
+  uint64_t seed = Playfield::kDefaultSeed;
+  std::string record;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+
+    if ("--ticks" == arg && i + 1 < argc) {
+      ticks = std::stoll(argv[++i]);
+    } else if ("--backend" == arg && i + 1 < argc) {
+      const std::string name = argv[++i];
+
+      backend = ("software" == name) ? Playfield::Backend::Software : Playfield::Backend::Null;
+    } else if ("--script" == arg && i + 1 < argc) {
+      script = LoadScript(argv[++i]);
+    } else if ("--replay" == arg && i + 1 < argc) {
+      script = LoadReplay(argv[++i], seed);
+      is_replay = true;
+    } else if ("--record" == arg && i + 1 < argc) {
+      record = argv[++i];
+    } else {
+      std::cout << "usage: qix_sim [--ticks n] [--backend null|software] [--script file | --replay file]"
+                << " [--record file]" << std::endl;
+      return -1;
+    }
+  }
+  if (script.empty()) {
+    script = CreateDefaultScript();
+  }
+  Playfield playfield(backend);
+  std::unique_ptr<ReplayRecorder> recorder;
+
+  playfield.SetSeed(seed);
+  if (!record.empty()) {
+    recorder = std::make_unique<ReplayRecorder>(record, seed);
+  }
+  // The script repeats with this period, an input on the very last tick still gets its turn
+  const int64_t period = script.back().tick + 1;
+
+  if (0 == ticks) {
+    ticks = is_replay ? period : kDefaultTicks;
+  }
+  size_t next = 0;
+  int64_t offset = 0;
+
+  const auto start = HighResClock::now();
+  const auto allocations = utility::AllocationCount();
+
+  for (int64_t tick = 0; tick < ticks; ++tick) {
+    while (script[next].tick + offset == tick) {
+      Apply(playfield, script[next].control);
+      if (recorder) {
+        recorder->Add(tick, script[next].control);
+      }
+      if (++next == script.size()) {
+        next = 0;
+        offset += period;
+      }
+    }
+    if (recorder && 0 == tick % kLogicTicksPerSecond) {
+      recorder->Flush();
+    }
+    playfield.Update(kLogicTick);
+    playfield.Render(1.0);
+  }
+  const std::chrono::duration<double> elapsed = HighResClock::now() - start;
+  const auto allocated = utility::AllocationCount() - allocations;
+
+  std::cout << "backend: " << ((Playfield::Backend::Software == backend) ? "software" : "null") << std::endl;
+  std::cout << "ticks: " << ticks << std::endl;
+  std::cout << "seconds: " << std::fixed << std::setprecision(3) << elapsed.count() << std::endl;
+  std::cout << "ticks/s: " << std::setprecision(0) << ticks / elapsed.count() << std::endl;
+  std::cout << "claimed: " << std::setprecision(2) << playfield.ClaimedPercentage() << "%" << std::endl;
+  if (utility::kCountAllocations) {
+    std::cout << "allocations: " << allocated << std::endl;
+  }
+
+  return 0;
+}
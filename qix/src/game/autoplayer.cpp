@@ -0,0 +1,142 @@
+#include "game/autoplayer.h"
+
+#include <climits>
+
+namespace {
+
+using Controls = Playfield::Controls;
+
+const std::array<Controls, 4> kDirections = { Controls::Left, Controls::Right, Controls::Up, Controls::Down };
+const int kMinDepth = 8;
+const int kMaxDepth = 120;
+const int kMinWidth = 8;
+const int kMaxWidth = 150;
+const int kMaxEdgeWalk = 60;
+
+SDL_Point Offset(Controls control) {
+  switch (control) {
+    case Controls::Left:
+      return { -1, 0 };
+    case Controls::Right:
+      return { 1, 0 };
+    case Controls::Up:
+      return { 0, -1 };
+    case Controls::Down:
+      return { 0, 1 };
+    default:
+      return { 0, 0 };
+  }
+}
+
+Controls Opposite(Controls control) {
+  switch (control) {
+    case Controls::Left:
+      return Controls::Right;
+    case Controls::Right:
+      return Controls::Left;
+    case Controls::Up:
+      return Controls::Down;
+    case Controls::Down:
+      return Controls::Up;
+    default:
+      return Controls::None;
+  }
+}
+
+// The cell the control moves the player to, Stix if that is outside the grid
+Grid::Cell Neighbor(const Playfield& playfield, Controls control) {
+  const auto pt = playfield.player();
+  const auto offset = Offset(control);
+  const auto& grid = playfield.grid();
+
+  return grid.IsInside(pt.x + offset.x, pt.y + offset.y) ? grid.Get(pt.x + offset.x, pt.y + offset.y)
+                                                         : Grid::Cell::Stix;
+}
+
+}  // namespace
+
+Autoplayer::Autoplayer(uint64_t seed, int step_ticks) : random_(seed), step_ticks_(step_ticks) {}
+
+Autoplayer::Controls Autoplayer::Next(const Playfield& playfield) {
+  if (0 != tick_++ % step_ticks_) {
+    return Controls::None;
+  }
+  // The stix was closed or cut, either way the box is done
+  if (was_drawing_ && !playfield.IsDrawing()) {
+    step_ = plan_.size();
+  }
+  was_drawing_ = playfield.IsDrawing();
+  if (step_ >= plan_.size()) {
+    Plan(playfield);
+  }
+  const auto next = Neighbor(playfield, plan_[step_].control);
+
+  if (Grid::Cell::Edge != next && Grid::Cell::Unclaimed != next) {
+    if (playfield.IsDrawing()) {
+      Escape(playfield);
+    } else {
+      Plan(playfield);
+    }
+  }
+  auto& step = plan_[step_];
+  const auto control = step.control;
+
+  if (kUntilEdge != step.count && 0 == --step.count) {
+    step_++;
+  }
+  return control;
+}
+
+void Autoplayer::Plan(const Playfield& playfield) {
+  std::array<Controls, 4> open;
+  std::array<Controls, 4> edges;
+  int open_count = 0;
+  int edge_count = 0;
+
+  for (auto control : kDirections) {
+    const auto cell = Neighbor(playfield, control);
+
+    if (Grid::Cell::Unclaimed == cell) {
+      open[open_count++] = control;
+    } else if (Grid::Cell::Edge == cell) {
+      edges[edge_count++] = control;
+    }
+  }
+  if (0 == open_count) {
+    // Nothing to claim from here, walk along the edge
+    step_ = plan_.size() - 1;
+    plan_[step_] = { (0 == edge_count) ? Controls::None : edges[Random(0, edge_count - 1)], Random(1, kMaxEdgeWalk) };
+    return;
+  }
+  const auto in = open[Random(0, open_count - 1)];
+  const bool vertical = Controls::Up == in || Controls::Down == in;
+  const auto turn = vertical ? (Random(0, 1) ? Controls::Left : Controls::Right)
+                             : (Random(0, 1) ? Controls::Up : Controls::Down);
+
+  step_ = 0;
+  plan_[0] = { in, Random(kMinDepth, kMaxDepth) };
+  plan_[1] = { turn, Random(kMinWidth, kMaxWidth) };
+  plan_[2] = { Opposite(in), kUntilEdge };
+}
+
+void Autoplayer::Escape(const Playfield& playfield) {
+  const auto pt = playfield.player();
+  const auto& grid = playfield.grid();
+  // Cells to the border of the grid in every direction
+  const std::array<int, 4> distances = { pt.x, grid.width() - 1 - pt.x, pt.y, grid.height() - 1 - pt.y };
+  Controls free = Controls::None;
+  int shortest = INT_MAX;
+
+  // Straight onto an edge if there is one next to the player, otherwise towards the nearest border
+  for (size_t i = 0; i < kDirections.size(); ++i) {
+    const auto cell = Neighbor(playfield, kDirections[i]);
+    const int distance = (Grid::Cell::Edge == cell) ? 0 : distances[i];
+
+    if ((Grid::Cell::Edge == cell || Grid::Cell::Unclaimed == cell) && distance < shortest) {
+      free = kDirections[i];
+      shortest = distance;
+    }
+  }
+  step_ = plan_.size() - 1;
+  plan_[step_] = { free, kUntilEdge };
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "game/playfield.h"
+#include "utility/xoshiro.h"
+
+#include <array>
+#include <cstdint>
+
+// Plays the game by drawing boxes out from the edges. A box goes straight in from an edge, turns
+// once and heads back until the stix meets an edge again. Sizes and turns come from a seeded
+// generator, the same seed plays the same game. It only looks at the playfield, one autoplayer
+// per playfield and they share nothing.
+class Autoplayer final {
+ public:
+  using Controls = Playfield::Controls;
+
+  // The player takes a step every step_ticks logic ticks
+  explicit Autoplayer(uint64_t seed, int step_ticks = 2);
+
+  Autoplayer(const Autoplayer&) = delete;
+
+  // The control to apply this tick, None between steps
+  Controls Next(const Playfield& playfield);
+
+ protected:
+  struct Step {
+    Controls control = Controls::None;
+    // Steps left, kUntilEdge keeps going until the stix is closed
+    int count = 0;
+  };
+
+  static constexpr int kUntilEdge = -1;
+
+  void Plan(const Playfield& playfield);
+
+  // Blocked while drawing, heads for an edge, or any free cell, next to the player
+  void Escape(const Playfield& playfield);
+
+  inline int Random(int min, int max) { return random_.UniformInt(min, max); }
+
+ private:
+  utility::Xoshiro256 random_;
+  int step_ticks_;
+  int64_t tick_ = 0;
+  std::array<Step, 3> plan_ = {};
+  size_t step_ = plan_.size();
+  bool was_drawing_ = false;
+};
@@ -0,0 +1,358 @@
+#include "game/border_graph.h"
+
+#include <cstdlib>
+#include <utility>
+#include <algorithm>
+
+namespace {
+
+using Direction = BorderGraph::Direction;
+
+// Nodes and edges reserved up front, a heavily fragmented board has a few hundred of each
+const size_t kReservedNodes = 4096;
+const size_t kReservedEdges = 4096;
+
+const std::array<int, 4> kDx = { -1, 1, 0, 0 };
+const std::array<int, 4> kDy = { 0, 0, -1, 1 };
+
+inline size_t ToIndex(Direction direction) { return static_cast<size_t>(direction); }
+
+inline Direction ToDirection(int dx, int dy) {
+  if (0 != dx) {
+    return (dx < 0) ? Direction::Left : Direction::Right;
+  }
+  return (dy < 0) ? Direction::Up : Direction::Down;
+}
+
+inline bool IsHorizontal(Direction direction) { return Direction::Left == direction || Direction::Right == direction; }
+
+// Right and down lead from the a end of an edge towards the b end
+inline bool IsForward(Direction direction) { return Direction::Right == direction || Direction::Down == direction; }
+
+Direction Opposite(Direction direction) {
+  switch (direction) {
+    case Direction::Left:
+      return Direction::Right;
+    case Direction::Right:
+      return Direction::Left;
+    case Direction::Up:
+      return Direction::Down;
+    default:
+      return Direction::Up;
+  }
+}
+
+// Screen coordinates, a right turn while heading right heads down
+Direction Rotate(Direction direction, BorderGraph::Turn turn) {
+  const bool right = BorderGraph::Turn::Right == turn;
+
+  switch (direction) {
+    case Direction::Left:
+      return right ? Direction::Up : Direction::Down;
+    case Direction::Right:
+      return right ? Direction::Down : Direction::Up;
+    case Direction::Up:
+      return right ? Direction::Right : Direction::Left;
+    default:
+      return right ? Direction::Left : Direction::Right;
+  }
+}
+
+BorderGraph::Turn Other(BorderGraph::Turn turn) {
+  return (BorderGraph::Turn::Left == turn) ? BorderGraph::Turn::Right : BorderGraph::Turn::Left;
+}
+
+}  // namespace
+
+BorderGraph::BorderGraph(int width, int height)
+    : width_(width), height_(height), cells_(static_cast<size_t>(width) * height, kNone) {
+  nodes_.reserve(kReservedNodes);
+  edges_.reserve(kReservedEdges);
+  free_nodes_.reserve(kReservedNodes);
+  free_edges_.reserve(kReservedEdges);
+  touched_edges_.reserve(kReservedEdges);
+  touched_nodes_.reserve(2 * kReservedEdges);
+  Reset();
+}
+
+void BorderGraph::Reset() {
+  std::fill(cells_.begin(), cells_.end(), kNone);
+  nodes_.clear();
+  edges_.clear();
+  free_nodes_.clear();
+  free_edges_.clear();
+
+  const auto top_left = AddNode(0, 0);
+  const auto top_right = AddNode(width_ - 1, 0);
+  const auto bottom_left = AddNode(0, height_ - 1);
+  const auto bottom_right = AddNode(width_ - 1, height_ - 1);
+
+  AddEdge(top_left, top_right);
+  AddEdge(top_right, bottom_right);
+  AddEdge(bottom_left, bottom_right);
+  AddEdge(top_left, bottom_left);
+}
+
+void BorderGraph::AddPath(SDL_Point start, const std::vector<SDL_Point>& stix, SDL_Point end) {
+  auto previous = SplitAt(start.x, start.y);
+  SDL_Point last = start;
+
+  // Only the cells where the stix turns become nodes
+  for (size_t i = 0; i < stix.size(); ++i) {
+    const auto& pt = stix[i];
+    const auto& next = (i + 1 < stix.size()) ? stix[i + 1] : end;
+
+    if (next.x - pt.x != pt.x - last.x || next.y - pt.y != pt.y - last.y) {
+      const auto node = AddNode(pt.x, pt.y);
+
+      AddEdge(previous, node);
+      previous = node;
+    }
+    last = pt;
+  }
+  const auto node = SplitAt(end.x, end.y);
+
+  AddEdge(previous, node);
+}
+
+void BorderGraph::Update(const Grid& grid, int y1, int y2) {
+  touched_edges_.clear();
+  touched_nodes_.clear();
+  for (size_t e = 0; e < edges_.size(); ++e) {
+    const auto& edge = edges_[e];
+
+    if (edge.alive && nodes_[edge.b].y >= y1 && nodes_[edge.a].y <= y2) {
+      touched_edges_.push_back(static_cast<int32_t>(e));
+    }
+  }
+  for (auto e : touched_edges_) {
+    const Edge edge = edges_[e];
+    const int x = nodes_[edge.a].x;
+    const int y = nodes_[edge.a].y;
+    const int dx = edge.horizontal ? 1 : 0;
+    const int dy = edge.horizontal ? 0 : 1;
+    auto is_edge = [&grid, x, y, dx, dy](int i) { return Grid::Cell::Edge == grid.Get(x + i * dx, y + i * dy); };
+    int i = 0;
+
+    while (i <= edge.length && is_edge(i)) {
+      i++;
+    }
+    if (i > edge.length) {
+      continue;
+    }
+    // What is left of the edge are the runs of cells still on the border
+    RemoveEdge(e);
+    touched_nodes_.push_back(edge.a);
+    touched_nodes_.push_back(edge.b);
+    for (int first = 0; first <= edge.length;) {
+      if (!is_edge(first)) {
+        first++;
+        continue;
+      }
+      int last = first;
+
+      while (last < edge.length && is_edge(last + 1)) {
+        last++;
+      }
+      if (last > first) {
+        const auto a = (0 == first) ? edge.a : AddNode(x + first * dx, y + first * dy);
+        const auto b = (edge.length == last) ? edge.b : AddNode(x + last * dx, y + last * dy);
+
+        AddEdge(a, b);
+        touched_nodes_.push_back(a);
+        touched_nodes_.push_back(b);
+      }
+      first = last + 1;
+    }
+  }
+  for (auto node : touched_nodes_) {
+    if (nodes_[node].alive && 0 == Degree(node)) {
+      RemoveNode(node);
+    }
+  }
+  for (auto node : touched_nodes_) {
+    if (nodes_[node].alive) {
+      MergeStraight(node);
+    }
+  }
+}
+
+bool BorderGraph::Connects(int x, int y, int dx, int dy) const {
+  const auto owner = cells_[index(x, y)];
+
+  if (kNone == owner) {
+    return false;
+  }
+  if (IsNode(owner)) {
+    return kNone != nodes_[NodeOwner(owner)].edges[ToIndex(ToDirection(dx, dy))];
+  }
+  return edges_[owner].horizontal == (0 != dx);
+}
+
+bool BorderGraph::Walk(Walker& walker, int steps, Turn turn) const {
+  while (steps > 0) {
+    const auto owner = cells_[index(walker.x, walker.y)];
+
+    if (kNone == owner) {
+      return false;
+    }
+    int32_t id = owner;
+
+    if (IsNode(owner)) {
+      const auto& node = nodes_[NodeOwner(owner)];
+      const std::array<Direction, 4> choices = {
+        Rotate(walker.direction, turn), walker.direction, Rotate(walker.direction, Other(turn)),
+        Opposite(walker.direction)
+      };
+      const auto choice = std::find_if(choices.begin(), choices.end(), [&node](Direction direction) {
+        return kNone != node.edges[ToIndex(direction)];
+      });
+
+      if (choices.end() == choice) {
+        return false;
+      }
+      walker.direction = *choice;
+      id = node.edges[ToIndex(walker.direction)];
+    } else if (edges_[id].horizontal != IsHorizontal(walker.direction)) {
+      // The border changed under the walker, it follows the edge it is on now
+      walker.direction = edges_[id].horizontal ? Direction::Right : Direction::Down;
+    }
+    const auto& edge = edges_[id];
+    const auto& end = nodes_[IsForward(walker.direction) ? edge.b : edge.a];
+    const int move = std::min(steps, std::abs(end.x - walker.x) + std::abs(end.y - walker.y));
+
+    walker.x += kDx[ToIndex(walker.direction)] * move;
+    walker.y += kDy[ToIndex(walker.direction)] * move;
+    steps -= move;
+  }
+  return true;
+}
+
+int BorderGraph::length() const {
+  int length = 0;
+
+  for (const auto& edge : edges_) {
+    length += edge.alive ? edge.length : 0;
+  }
+  return length;
+}
+
+int32_t BorderGraph::AddNode(int x, int y) {
+  int32_t id = static_cast<int32_t>(nodes_.size());
+
+  if (free_nodes_.empty()) {
+    nodes_.emplace_back();
+  } else {
+    id = free_nodes_.back();
+    free_nodes_.pop_back();
+  }
+  auto& node = nodes_[id];
+
+  node = Node{ x, y };
+  node.alive = true;
+  cells_[index(x, y)] = NodeOwner(id);
+
+  return id;
+}
+
+void BorderGraph::RemoveNode(int32_t id) {
+  auto& node = nodes_[id];
+
+  cells_[index(node.x, node.y)] = kNone;
+  node = Node{};
+  free_nodes_.push_back(id);
+}
+
+int32_t BorderGraph::AddEdge(int32_t first, int32_t second) {
+  if (nodes_[first].x > nodes_[second].x || nodes_[first].y > nodes_[second].y) {
+    std::swap(first, second);
+  }
+  int32_t id = static_cast<int32_t>(edges_.size());
+
+  if (free_edges_.empty()) {
+    edges_.emplace_back();
+  } else {
+    id = free_edges_.back();
+    free_edges_.pop_back();
+  }
+  auto& edge = edges_[id];
+  auto& a = nodes_[first];
+  auto& b = nodes_[second];
+
+  edge.a = first;
+  edge.b = second;
+  edge.horizontal = a.y == b.y;
+  edge.length = b.x - a.x + b.y - a.y;
+  edge.alive = true;
+  a.edges[ToIndex(edge.horizontal ? Direction::Right : Direction::Down)] = id;
+  b.edges[ToIndex(edge.horizontal ? Direction::Left : Direction::Up)] = id;
+  SetEdgeCells(edge, id);
+
+  return id;
+}
+
+void BorderGraph::RemoveEdge(int32_t id) {
+  auto& edge = edges_[id];
+
+  nodes_[edge.a].edges[ToIndex(edge.horizontal ? Direction::Right : Direction::Down)] = kNone;
+  nodes_[edge.b].edges[ToIndex(edge.horizontal ? Direction::Left : Direction::Up)] = kNone;
+  SetEdgeCells(edge, kNone);
+  edge = Edge{};
+  free_edges_.push_back(id);
+}
+
+void BorderGraph::SetEdgeCells(const Edge& edge, int32_t owner) {
+  const auto& a = nodes_[edge.a];
+  const int dx = edge.horizontal ? 1 : 0;
+  const int dy = edge.horizontal ? 0 : 1;
+
+  for (int i = 1; i < edge.length; ++i) {
+    cells_[index(a.x + i * dx, a.y + i * dy)] = owner;
+  }
+}
+
+int32_t BorderGraph::SplitAt(int x, int y) {
+  const auto owner = cells_[index(x, y)];
+
+  if (IsNode(owner)) {
+    return NodeOwner(owner);
+  }
+  if (kNone == owner) {
+    return AddNode(x, y);
+  }
+  const Edge edge = edges_[owner];
+
+  RemoveEdge(owner);
+
+  const auto node = AddNode(x, y);
+
+  AddEdge(edge.a, node);
+  AddEdge(node, edge.b);
+
+  return node;
+}
+
+void BorderGraph::MergeStraight(int32_t id) {
+  const auto edges = nodes_[id].edges;
+  const bool horizontal = kNone != edges[ToIndex(Direction::Left)] && kNone != edges[ToIndex(Direction::Right)];
+  const bool vertical = kNone != edges[ToIndex(Direction::Up)] && kNone != edges[ToIndex(Direction::Down)];
+
+  if (2 != Degree(id) || (!horizontal && !vertical)) {
+    return;
+  }
+  const auto before = edges[ToIndex(horizontal ? Direction::Left : Direction::Up)];
+  const auto after = edges[ToIndex(horizontal ? Direction::Right : Direction::Down)];
+  const auto a = edges_[before].a;
+  const auto b = edges_[after].b;
+
+  RemoveEdge(before);
+  RemoveEdge(after);
+  RemoveNode(id);
+  AddEdge(a, b);
+}
+
+int BorderGraph::Degree(int32_t id) const {
+  const auto& edges = nodes_[id].edges;
+
+  return static_cast<int>(std::count_if(edges.begin(), edges.end(), [](int32_t edge) { return kNone != edge; }));
+}
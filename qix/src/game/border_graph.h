@@ -0,0 +1,115 @@
+#pragma once
+
+#include "game/grid.h"
+
+#include <SDL.h>
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+// The edges of the playfield as a planar graph. Nodes sit on corners and junctions, every node
+// links to at most one edge in each direction and every edge is a horizontal or vertical run of
+// cells with its length stored. Each cell of the grid knows the node or edge it belongs to, so
+// looking up where something on the border is and where it can go next is O(1). A closed stix
+// is added as a path and a claim only revisits the edges in the rows it changed. Nodes and
+// edges removed are reused, a graph that has grown once stops allocating.
+class BorderGraph final {
+ public:
+  enum class Direction { Left, Right, Up, Down };
+  // Which way a walker turns at a junction, it follows the border of a region
+  enum class Turn { Left, Right };
+
+  struct Walker {
+    int x = 0;
+    int y = 0;
+    Direction direction = Direction::Right;
+  };
+
+  BorderGraph(int width, int height);
+
+  BorderGraph(const BorderGraph&) = delete;
+
+  // An edge along the border of the grid, as Grid::Reset
+  void Reset();
+
+  // Adds a closed stix running from start to end, both on the border already
+  void AddPath(SDL_Point start, const std::vector<SDL_Point>& stix, SDL_Point end);
+
+  // Drops every cell in rows y1 to y2 that is no longer an edge in the grid
+  void Update(const Grid& grid, int y1, int y2);
+
+  inline bool IsOnBorder(int x, int y) const { return kNone != cells_[index(x, y)]; }
+
+  // True if one step of dx, dy from x, y follows the border
+  bool Connects(int x, int y, int dx, int dy) const;
+
+  // Moves the walker steps cells along the border, at a junction it takes the first of a turn
+  // to the given side, straight ahead and a turn to the other side. Returns false if the walker
+  // is not on the border.
+  bool Walk(Walker& walker, int steps, Turn turn) const;
+
+  inline size_t nodes() const { return nodes_.size() - free_nodes_.size(); }
+
+  inline size_t edges() const { return edges_.size() - free_edges_.size(); }
+
+  // The total length of all edges
+  int length() const;
+
+ protected:
+  static constexpr int32_t kNone = -1;
+
+  struct Node {
+    int x = 0;
+    int y = 0;
+    // The edge leaving the node in each direction
+    std::array<int32_t, 4> edges = { kNone, kNone, kNone, kNone };
+    bool alive = false;
+  };
+
+  struct Edge {
+    // a is left of, or above, b
+    int32_t a = kNone;
+    int32_t b = kNone;
+    int length = 0;
+    bool horizontal = false;
+    bool alive = false;
+  };
+
+  inline size_t index(int x, int y) const { return static_cast<size_t>(y) * width_ + x; }
+
+  // Cells hold an edge id, or a node id encoded as a negative number. The encoding is its own inverse.
+  static inline int32_t NodeOwner(int32_t node) { return -node - 2; }
+
+  static inline bool IsNode(int32_t owner) { return owner < kNone; }
+
+  int32_t AddNode(int x, int y);
+
+  void RemoveNode(int32_t node);
+
+  int32_t AddEdge(int32_t first, int32_t second);
+
+  // Unlinks the edge and clears its cells, the nodes are kept
+  void RemoveEdge(int32_t edge);
+
+  void SetEdgeCells(const Edge& edge, int32_t owner);
+
+  // The node at x, y, the edge running through it is split in two if there is none
+  int32_t SplitAt(int x, int y);
+
+  // A node between two edges in a straight line is not needed, the edges become one
+  void MergeStraight(int32_t node);
+
+  int Degree(int32_t node) const;
+
+ private:
+  int width_;
+  int height_;
+  std::vector<int32_t> cells_;
+  std::vector<Node> nodes_;
+  std::vector<Edge> edges_;
+  std::vector<int32_t> free_nodes_;
+  std::vector<int32_t> free_edges_;
+  std::vector<int32_t> touched_edges_;
+  std::vector<int32_t> touched_nodes_;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "game/grid.h"
+#include "game/flood_fill.h"
+#include "utility/bits.h"
+
+#include <vector>
+#include <algorithm>
+
+// Keeps count of the claimed cells on every row of the playfield. Counts are only
+// updated when area is claimed, reading the claimed percentage is O(1).
+class ClaimTracker final {
+ public:
+  ClaimTracker(int width, int height)
+      : total_(static_cast<size_t>(width) * height), rows_(height, 0) {}
+
+  void Reset() {
+    std::fill(rows_.begin(), rows_.end(), 0);
+    claimed_ = 0;
+  }
+
+  // Adds the cells set in a row of a one bit per cell bitset
+  void Add(int y, const uint64_t* bits, int words) {
+    int count = 0;
+
+    for (int i = 0; i < words; ++i) {
+      count += utility::PopCount(bits[i]);
+    }
+    rows_[y] += count;
+    claimed_ += count;
+  }
+
+  // Adds everything claimed by the last claim of the flood fill
+  void Add(const FloodFill& flood_fill) {
+    const auto [y1, y2] = flood_fill.claimed_rows();
+
+    for (int y = y1; y <= y2; ++y) {
+      Add(y, flood_fill.claimed_row(y), flood_fill.chunks_per_row());
+    }
+  }
+
+  // Counts the claimed cells of a row straight from the packed grid
+  void Recount(const Grid& grid, int y) {
+    const auto row = grid.row(y);
+    int count = 0;
+
+    for (int i = 0; i < grid.words_per_row(); ++i) {
+      count += utility::PopCount(row[i] & ~(row[i] >> 1) & 0x5555555555555555ull);
+    }
+    claimed_ = claimed_ - rows_[y] + count;
+    rows_[y] = count;
+  }
+
+  void Recount(const Grid& grid) {
+    for (int y = 0; y < grid.height(); ++y) {
+      Recount(grid, y);
+    }
+  }
+
+  inline int claimed(int y) const { return rows_[y]; }
+
+  inline size_t claimed() const { return claimed_; }
+
+  inline double Percentage() const { return (100.0 * claimed_) / total_; }
+
+ private:
+  size_t total_;
+  size_t claimed_ = 0;
+  std::vector<int> rows_;
+};
@@ -0,0 +1,176 @@
+#include "game/collision.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace {
+
+using Segment = SegmentGrid::Segment;
+
+// Stored segments cover a little more than their bounding box, a query passing exactly
+// through a cell corner still finds them
+const float kMargin = 0.5f;
+
+inline float Orientation(float px, float py, float qx, float qy, float rx, float ry) {
+  return (qx - px) * (ry - py) - (qy - py) * (rx - px);
+}
+
+// r is known to be on the line through p and q
+inline bool WithinBounds(float px, float py, float qx, float qy, float rx, float ry) {
+  return rx >= std::min(px, qx) && rx <= std::max(px, qx) && ry >= std::min(py, qy) && ry <= std::max(py, qy);
+}
+
+inline bool Opposite(float a, float b) { return (a > 0.0f && b < 0.0f) || (a < 0.0f && b > 0.0f); }
+
+// Clips the segment to the rectangle 0, 0, width, height. Returns false if nothing is left.
+bool Clip(Segment& s, float width, float height) {
+  const float dx = s.x2 - s.x1;
+  const float dy = s.y2 - s.y1;
+  const float p[4] = { -dx, dx, -dy, dy };
+  const float q[4] = { s.x1, width - s.x1, s.y1, height - s.y1 };
+  float t0 = 0.0f;
+  float t1 = 1.0f;
+
+  for (int i = 0; i < 4; ++i) {
+    if (0.0f == p[i]) {
+      if (q[i] < 0.0f) {
+        return false;
+      }
+      continue;
+    }
+    const float t = q[i] / p[i];
+
+    if (p[i] < 0.0f) {
+      t0 = std::max(t0, t);
+    } else {
+      t1 = std::min(t1, t);
+    }
+  }
+  if (t0 > t1) {
+    return false;
+  }
+  s = { s.x1 + t0 * dx, s.y1 + t0 * dy, s.x1 + t1 * dx, s.y1 + t1 * dy };
+
+  return true;
+}
+
+}  // namespace
+
+bool SegmentsIntersect(const Segment& a, const Segment& b) {
+  const float d1 = Orientation(b.x1, b.y1, b.x2, b.y2, a.x1, a.y1);
+  const float d2 = Orientation(b.x1, b.y1, b.x2, b.y2, a.x2, a.y2);
+  const float d3 = Orientation(a.x1, a.y1, a.x2, a.y2, b.x1, b.y1);
+  const float d4 = Orientation(a.x1, a.y1, a.x2, a.y2, b.x2, b.y2);
+
+  if (Opposite(d1, d2) && Opposite(d3, d4)) {
+    return true;
+  }
+  // Touching or overlapping
+  return (0.0f == d1 && WithinBounds(b.x1, b.y1, b.x2, b.y2, a.x1, a.y1)) ||
+         (0.0f == d2 && WithinBounds(b.x1, b.y1, b.x2, b.y2, a.x2, a.y2)) ||
+         (0.0f == d3 && WithinBounds(a.x1, a.y1, a.x2, a.y2, b.x1, b.y1)) ||
+         (0.0f == d4 && WithinBounds(a.x1, a.y1, a.x2, a.y2, b.x2, b.y2));
+}
+
+SegmentGrid::SegmentGrid(int width, int height, int cell_size)
+    : width_(width), height_(height), cell_size_(cell_size), columns_((width + cell_size - 1) / cell_size),
+      rows_((height + cell_size - 1) / cell_size), heads_(columns_ * rows_, kNone) {}
+
+void SegmentGrid::Add(const Segment& segment) {
+  const auto id = static_cast<uint32_t>(segments_.size());
+  const int cx1 = std::clamp(static_cast<int>(std::floor((std::min(segment.x1, segment.x2) - kMargin) / cell_size_)), 0, columns_ - 1);
+  const int cx2 = std::clamp(static_cast<int>(std::floor((std::max(segment.x1, segment.x2) + kMargin) / cell_size_)), 0, columns_ - 1);
+  const int cy1 = std::clamp(static_cast<int>(std::floor((std::min(segment.y1, segment.y2) - kMargin) / cell_size_)), 0, rows_ - 1);
+  const int cy2 = std::clamp(static_cast<int>(std::floor((std::max(segment.y1, segment.y2) + kMargin) / cell_size_)), 0, rows_ - 1);
+
+  segments_.push_back(segment);
+  visited_.push_back(0);
+  for (int cy = cy1; cy <= cy2; ++cy) {
+    for (int cx = cx1; cx <= cx2; ++cx) {
+      auto& head = heads_[index(cx, cy)];
+
+      if (kNone == head) {
+        used_cells_.push_back(index(cx, cy));
+      }
+      entries_.push_back({ id, head });
+      head = static_cast<int32_t>(entries_.size() - 1);
+    }
+  }
+}
+
+void SegmentGrid::Clear() {
+  for (auto i : used_cells_) {
+    heads_[i] = kNone;
+  }
+  used_cells_.clear();
+  entries_.clear();
+  segments_.clear();
+  visited_.clear();
+}
+
+// Walks the cells the segment passes through in order (Amanatides & Woo), until the
+// function returns true
+template<typename Function>
+void SegmentGrid::Traverse(Segment s, Function function) const {
+  if (!Clip(s, static_cast<float>(width_), static_cast<float>(height_))) {
+    return;
+  }
+  const float kInfinity = std::numeric_limits<float>::infinity();
+  const float dx = s.x2 - s.x1;
+  const float dy = s.y2 - s.y1;
+  int cx = std::min(static_cast<int>(s.x1) / cell_size_, columns_ - 1);
+  int cy = std::min(static_cast<int>(s.y1) / cell_size_, rows_ - 1);
+  const int end_cx = std::min(static_cast<int>(s.x2) / cell_size_, columns_ - 1);
+  const int end_cy = std::min(static_cast<int>(s.y2) / cell_size_, rows_ - 1);
+  const int step_x = (dx > 0.0f) ? 1 : -1;
+  const int step_y = (dy > 0.0f) ? 1 : -1;
+  const float delta_x = (0.0f != dx) ? cell_size_ / std::abs(dx) : kInfinity;
+  const float delta_y = (0.0f != dy) ? cell_size_ / std::abs(dy) : kInfinity;
+  float max_x = (0.0f != dx) ? ((cx + (step_x > 0 ? 1 : 0)) * cell_size_ - s.x1) / dx : kInfinity;
+  float max_y = (0.0f != dy) ? ((cy + (step_y > 0 ? 1 : 0)) * cell_size_ - s.y1) / dy : kInfinity;
+  // Rounding can not make the walk longer than this
+  int steps = std::abs(end_cx - cx) + std::abs(end_cy - cy);
+
+  while (!function(index(cx, cy)) && steps-- > 0) {
+    if (max_x < max_y) {
+      cx += step_x;
+      max_x += delta_x;
+    } else {
+      cy += step_y;
+      max_y += delta_y;
+    }
+    if (cx < 0 || cx >= columns_ || cy < 0 || cy >= rows_) {
+      return;
+    }
+  }
+}
+
+bool SegmentGrid::Intersects(const Segment& segment) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (0 == ++query_) {
+    std::fill(visited_.begin(), visited_.end(), 0);
+    query_ = 1;
+  }
+  bool hit = false;
+
+  Traverse(segment, [this, &segment, &hit](int cell) {
+    for (auto entry = heads_[cell]; kNone != entry; entry = entries_[entry].next) {
+      const auto id = entries_[entry].id;
+
+      if (visited_[id] == query_) {
+        continue;
+      }
+      visited_[id] = query_;
+      if (SegmentsIntersect(segments_[id], segment)) {
+        hit = true;
+        return true;
+      }
+    }
+    return false;
+  });
+
+  return hit;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Line segments bucketed into a uniform grid of square cells. A segment is stored in every cell
+// its bounding box touches. A query only walks the cells the query segment passes through and
+// tests every stored segment at most once, so its cost depends on how crowded those cells are
+// and not on how many segments there are in total. Every cell is a linked list threaded through
+// one shared entry array, clearing keeps the memory so a grid that is refilled stops allocating.
+class SegmentGrid final {
+ public:
+  struct Segment {
+    float x1;
+    float y1;
+    float x2;
+    float y2;
+  };
+
+  SegmentGrid(int width, int height, int cell_size);
+
+  SegmentGrid(const SegmentGrid&) = delete;
+
+  void Add(const Segment& segment);
+
+  // Empties every cell used since the last clear, not the whole grid
+  void Clear();
+
+  bool Intersects(const Segment& segment) const;
+
+  inline size_t size() const { return segments_.size(); }
+
+  inline const std::vector<Segment>& segments() const { return segments_; }
+
+ protected:
+  static constexpr int32_t kNone = -1;
+
+  // A segment in a cell, next is the following entry of the same cell
+  struct Entry {
+    uint32_t id;
+    int32_t next;
+  };
+
+  inline int index(int cx, int cy) const { return cy * columns_ + cx; }
+
+  template<typename Function>
+  void Traverse(Segment segment, Function function) const;
+
+ private:
+  int width_;
+  int height_;
+  int cell_size_;
+  int columns_;
+  int rows_;
+  std::vector<Segment> segments_;
+  std::vector<int32_t> heads_;
+  std::vector<Entry> entries_;
+  std::vector<int> used_cells_;
+  mutable std::vector<uint32_t> visited_;
+  mutable uint32_t query_ = 0;
+};
+
+bool SegmentsIntersect(const SegmentGrid::Segment& a, const SegmentGrid::Segment& b);
+
+// Collision between the stix the player is drawing and the things that move on the playfield.
+// The trail only grows while a stix is drawn, moving segments are replaced every logic tick.
+class Collision final {
+ public:
+  using Segment = SegmentGrid::Segment;
+
+  static constexpr int kCellSize = 16;
+
+  Collision(int width, int height) : trail_(width, height, kCellSize), movers_(width, height, kCellSize) {}
+
+  Collision(const Collision&) = delete;
+
+  inline void AddTrail(const Segment& segment) { trail_.Add(segment); }
+
+  inline void ClearTrail() { trail_.Clear(); }
+
+  inline void AddMover(const Segment& segment) { movers_.Add(segment); }
+
+  inline void ClearMovers() { movers_.Clear(); }
+
+  inline bool HitsTrail(const Segment& segment) const { return trail_.Intersects(segment); }
+
+  inline bool HitsMover(const Segment& segment) const { return movers_.Intersects(segment); }
+
+  inline size_t trail_size() const { return trail_.size(); }
+
+ private:
+  SegmentGrid trail_;
+  SegmentGrid movers_;
+};
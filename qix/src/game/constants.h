@@ -6,3 +6,4 @@ const int kPlayFieldStartX = 200;
 const int kPlayFieldStartY = 60;
 const int kPlayFieldWidth = 800;
 const int kPlayFieldHeight = 800;
+const int kLogicTicksPerSecond = 120;
@@ -0,0 +1,80 @@
+#include "game/distance_field.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+const uint16_t kStraight = 3;
+const uint16_t kDiagonal = 4;
+const uint16_t kFar = UINT16_MAX - kDiagonal;
+
+static_assert(0 == Grid::kCellsPerWord % DistanceField::kCellSize, "A block must not straddle two words");
+
+const int kBlocksPerWord = Grid::kCellsPerWord / DistanceField::kCellSize;
+const uint64_t kBlockMask = (1ull << (DistanceField::kCellSize * Grid::kBitsPerCell)) - 1;
+
+}  // namespace
+
+DistanceField::DistanceField(int width, int height)
+    : height_(height), columns_((width + kCellSize - 1) / kCellSize),
+      rows_((height + kCellSize - 1) / kCellSize), distances_(static_cast<size_t>(columns_) * rows_, 0),
+      blocked_((width + Grid::kCellsPerWord - 1) / Grid::kCellsPerWord) {}
+
+void DistanceField::Build(const Grid& grid) {
+  // Unclaimed cells are zero, a block with any bit set in the rows it covers is a wall
+  for (int row = 0; row < rows_; ++row) {
+    std::fill(blocked_.begin(), blocked_.end(), 0);
+    for (int y = row * kCellSize; y < std::min((row + 1) * kCellSize, height_); ++y) {
+      const auto cells = grid.row(y);
+
+      for (int i = 0; i < grid.words_per_row(); ++i) {
+        blocked_[i] |= cells[i];
+      }
+    }
+    for (int column = 0; column < columns_; ++column) {
+      const auto word = blocked_[column / kBlocksPerWord];
+      const auto block = (word >> ((column % kBlocksPerWord) * kCellSize * Grid::kBitsPerCell)) & kBlockMask;
+
+      distances_[static_cast<size_t>(row) * columns_ + column] = (0 == block) ? kFar : 0;
+    }
+  }
+  auto relax = [this](int column, int row, int dx, int dy, uint16_t step) {
+    auto& distance = distances_[static_cast<size_t>(row) * columns_ + column];
+
+    distance = std::min<uint16_t>(distance, at(column + dx, row + dy) + step);
+  };
+
+  // Forward from the top left, then back from the bottom right
+  for (int row = 0; row < rows_; ++row) {
+    for (int column = 0; column < columns_; ++column) {
+      relax(column, row, -1, 0, kStraight);
+      relax(column, row, 0, -1, kStraight);
+      relax(column, row, -1, -1, kDiagonal);
+      relax(column, row, 1, -1, kDiagonal);
+    }
+  }
+  for (int row = rows_ - 1; row >= 0; --row) {
+    for (int column = columns_ - 1; column >= 0; --column) {
+      relax(column, row, 1, 0, kStraight);
+      relax(column, row, 0, 1, kStraight);
+      relax(column, row, 1, 1, kDiagonal);
+      relax(column, row, -1, 1, kDiagonal);
+    }
+  }
+}
+
+void DistanceField::Gradient(float x, float y, float& gx, float& gy) const {
+  const int column = Column(x);
+  const int row = Row(y);
+
+  gx = static_cast<float>(at(column + 1, row) - at(column - 1, row));
+  gy = static_cast<float>(at(column, row + 1) - at(column, row - 1));
+
+  const float length = std::sqrt(gx * gx + gy * gy);
+
+  if (length > 0.0f) {
+    gx /= length;
+    gy /= length;
+  }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "game/grid.h"
+
+#include <vector>
+#include <cstdint>
+
+// Distance from every block of kCellSize x kCellSize cells to the nearest block holding
+// anything but unclaimed cells, outside the grid counts as such a block. Built with a two pass
+// 3-4 chamfer transform, the coarse field of a whole playfield is a few thousand blocks, so
+// rebuilding it after a claim is cheap. Looking up a distance or the way away from the walls
+// is O(1).
+class DistanceField final {
+ public:
+  // Blocks are read straight from the packed rows of the grid, a word holds whole blocks
+  static constexpr int kCellSize = 8;
+
+  DistanceField(int width, int height);
+
+  DistanceField(const DistanceField&) = delete;
+
+  void Build(const Grid& grid);
+
+  // Pixels to the nearest wall, zero inside one
+  inline float Distance(float x, float y) const { return at(Column(x), Row(y)) * kPixelsPerStep; }
+
+  inline bool IsBlocked(float x, float y) const { return 0 == at(Column(x), Row(y)); }
+
+  // Unit vector away from the nearest walls, zero where the field is flat
+  void Gradient(float x, float y, float& gx, float& gy) const;
+
+  // Chamfer steps, 3 for a block straight across and 4 diagonally
+  inline uint16_t at(int column, int row) const {
+    return (column < 0 || row < 0 || column >= columns_ || row >= rows_)
+        ? 0 : distances_[static_cast<size_t>(row) * columns_ + column];
+  }
+
+  inline int columns() const { return columns_; }
+
+  inline int rows() const { return rows_; }
+
+ protected:
+  static constexpr float kPixelsPerStep = static_cast<float>(kCellSize) / 3.0f;
+
+  inline int Column(float x) const { return static_cast<int>(x) / kCellSize - (x < 0.0f ? 1 : 0); }
+
+  inline int Row(float y) const { return static_cast<int>(y) / kCellSize - (y < 0.0f ? 1 : 0); }
+
+ private:
+  int height_;
+  int columns_;
+  int rows_;
+  std::vector<uint16_t> distances_;
+  // The cells of a row of blocks, or'ed together
+  std::vector<uint64_t> blocked_;
+};
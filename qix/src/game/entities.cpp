@@ -0,0 +1,121 @@
+#include "game/entities.h"
+
+#include <cmath>
+
+namespace {
+
+const float kPiDiv180 = static_cast<float>(M_PI / 180.0);
+
+}  // namespace
+
+Entities::Entities(size_t capacity)
+    : x_(capacity), y_(capacity), previous_x_(capacity), previous_y_(capacity), vx_(capacity), vy_(capacity),
+      ex_(capacity), ey_(capacity), color_(capacity, utility::Color::None), owner_(capacity), sparse_(capacity) {
+  free_.reserve(capacity);
+  for (size_t i = capacity; i > 0; --i) {
+    free_.push_back(static_cast<uint32_t>(i - 1));
+  }
+}
+
+Entities::Handle Entities::Create(float x, float y, int direction, int length, float velocity, utility::Color color) {
+  if (free_.empty()) {
+    return Handle();
+  }
+  const auto index = free_.back();
+  const auto n = size_++;
+  const float heading = kPiDiv180 * direction;
+  const float orientation = kPiDiv180 * (direction + 90);
+  const float radius = length / 2.0f;
+
+  free_.pop_back();
+  sparse_[index].dense = static_cast<uint32_t>(n);
+  owner_[n] = index;
+  x_[n] = previous_x_[n] = x;
+  y_[n] = previous_y_[n] = y;
+  // Screen y grows downwards
+  vx_[n] = std::cos(heading) * velocity;
+  vy_[n] = -std::sin(heading) * velocity;
+  ex_[n] = std::cos(orientation) * radius;
+  ey_[n] = -std::sin(orientation) * radius;
+  color_[n] = color;
+
+  return { index, sparse_[index].generation };
+}
+
+bool Entities::Destroy(Handle handle) {
+  const auto n = dense(handle);
+
+  if (kNone == n) {
+    return false;
+  }
+  const auto last = --size_;
+
+  if (n != last) {
+    Move(n, last);
+  }
+  sparse_[handle.index].dense = kNone;
+  sparse_[handle.index].generation++;
+  free_.push_back(handle.index);
+
+  return true;
+}
+
+void Entities::Clear() {
+  for (size_t n = 0; n < size_; ++n) {
+    auto& slot = sparse_[owner_[n]];
+
+    slot.dense = kNone;
+    slot.generation++;
+    free_.push_back(owner_[n]);
+  }
+  size_ = 0;
+}
+
+void Entities::SetPosition(Handle handle, float x, float y) {
+  const auto n = dense(handle);
+
+  assert(kNone != n);
+  x_[n] = x;
+  y_[n] = y;
+}
+
+void Entities::Move(size_t to, size_t from) {
+  x_[to] = x_[from];
+  y_[to] = y_[from];
+  previous_x_[to] = previous_x_[from];
+  previous_y_[to] = previous_y_[from];
+  vx_[to] = vx_[from];
+  vy_[to] = vy_[from];
+  ex_[to] = ex_[from];
+  ey_[to] = ey_[from];
+  color_[to] = color_[from];
+  owner_[to] = owner_[from];
+  sparse_[owner_[to]].dense = static_cast<uint32_t>(to);
+}
+
+void Entities::Update(double delta) {
+  const size_t n = size_;
+  const float d = static_cast<float>(delta);
+  float* x = x_.data();
+  float* y = y_.data();
+  float* previous_x = previous_x_.data();
+  float* previous_y = previous_y_.data();
+  const float* vx = vx_.data();
+  const float* vy = vy_.data();
+
+  for (size_t i = 0; i < n; ++i) {
+    previous_x[i] = x[i];
+    previous_y[i] = y[i];
+    x[i] += vx[i] * d;
+    y[i] += vy[i] * d;
+  }
+}
+
+void Entities::Render(utility::CommandBuffer& commands, float alpha) const {
+  for (size_t i = 0; i < size_; ++i) {
+    const float x = previous_x_[i] + (x_[i] - previous_x_[i]) * alpha;
+    const float y = previous_y_[i] + (y_[i] - previous_y_[i]) * alpha;
+
+    commands.Add(x + ex_[i], y + ey_[i], x - ex_[i], y - ey_[i], color_[i]);
+  }
+}
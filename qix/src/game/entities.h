@@ -0,0 +1,93 @@
+#pragma once
+
+#include "utility/color.h"
+#include "utility/render_commands.h"
+#include "utility/object_pool.h"
+
+#include <vector>
+#include <cassert>
+
+// Moving line shaped entities (sparx, fuses, particles) stored as one array per component:
+// position, velocity and appearance. Live entities are packed at the front of the arrays, so
+// the update is one loop over contiguous floats and the render pass records them all as line
+// commands, drawn as one batch. Handles stay valid while entities are destroyed and moved
+// around in the arrays.
+class Entities final {
+ public:
+  using Handle = utility::PoolHandle;
+
+  explicit Entities(size_t capacity);
+
+  Entities(const Entities&) = delete;
+
+  // Direction is in degrees counter clockwise with 0 pointing right, the line is drawn
+  // perpendicular to it. Returns an invalid handle if there is no room.
+  Handle Create(float x, float y, int direction, int length, float velocity, utility::Color color);
+
+  // The last entity is moved into the hole
+  bool Destroy(Handle handle);
+
+  // Destroys every entity, the storage is kept for the next level
+  void Clear();
+
+  inline bool Contains(Handle handle) const { return kNone != dense(handle); }
+
+  void Update(double delta);
+
+  // Records every entity as a line, alpha of the way from its position before the last update
+  void Render(utility::CommandBuffer& commands, float alpha) const;
+
+  // Puts an entity at x, y outside of the update pass, for entities that do not move by
+  // velocity, like the Sparx following the border. Call it after Update(), the entity renders
+  // moving from where it was before that update.
+  void SetPosition(Handle handle, float x, float y);
+
+  inline float x(Handle handle) const {
+    assert(Contains(handle));
+    return x_[dense(handle)];
+  }
+
+  inline float y(Handle handle) const {
+    assert(Contains(handle));
+    return y_[dense(handle)];
+  }
+
+  inline size_t size() const { return size_; }
+
+  inline size_t capacity() const { return x_.size(); }
+
+ protected:
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  // Index into the component arrays, kNone if the handle is stale
+  inline uint32_t dense(Handle handle) const {
+    return (handle.index < sparse_.size() && sparse_[handle.index].generation == handle.generation)
+        ? sparse_[handle.index].dense : kNone;
+  }
+
+  void Move(size_t to, size_t from);
+
+ private:
+  struct Slot {
+    uint32_t dense = kNone;
+    uint32_t generation = 0;
+  };
+
+  size_t size_ = 0;
+  // Position
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> previous_x_;
+  std::vector<float> previous_y_;
+  // Velocity
+  std::vector<float> vx_;
+  std::vector<float> vy_;
+  // Appearance, the vector from the center to one end of the line
+  std::vector<float> ex_;
+  std::vector<float> ey_;
+  std::vector<utility::Color> color_;
+  // Handle slot of the entity at each index, and where each handle slot points
+  std::vector<uint32_t> owner_;
+  std::vector<Slot> sparse_;
+  std::vector<uint32_t> free_;
+};
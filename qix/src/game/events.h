@@ -1,17 +1,48 @@
 #pragma once
 
-#include <deque>
+#include <array>
 #include <vector>
+#include <cstdint>
+#include <cstring>
 #include <algorithm>
+#include <type_traits>
+#include <initializer_list>
 
 struct Event {
-  enum class Type {
-    None
+  enum class Type : uint8_t {
+    None,
+    NewGame,
+    Pause,
+    AreaClaimed,
+    StixCut,
+    Count
   };
+  static constexpr size_t kTypeCount = static_cast<size_t>(Type::Count);
+  static constexpr size_t kPayloadSize = 16;
+
+  Event() = default;
 
   inline explicit Event(Type type) : type_(type) {}
 
-  Type type_;
+  // The payload is copied into the event, it must be trivially copyable and fit in kPayloadSize
+  template<typename T>
+  Event(Type type, const T& payload) : type_(type) {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= kPayloadSize, "Payload does not fit in an event");
+    std::memcpy(payload_.data(), &payload, sizeof(T));
+  }
+
+  template<typename T>
+  T payload() const {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= kPayloadSize, "Payload does not fit in an event");
+    T value;
+
+    std::memcpy(&value, payload_.data(), sizeof(T));
+
+    return value;
+  }
+
+  Type type_ = Type::None;
+  alignas(8) std::array<uint8_t, kPayloadSize> payload_ = {};
 };
 
 inline bool IsIn(Event::Type type, const std::initializer_list<Event::Type>& list) {
@@ -25,45 +56,205 @@ class EventListener {
   virtual void Update(const Event& event) = 0;
 };
 
+// Fixed capacity ring of events that never allocates. A bitmask tells which types are queued,
+// and removing every queued event of a type is O(1): the type remembers the sequence number it
+// was removed at and older events of that type are skipped when they reach the front. Listeners
+// subscribe to the types they care about and only see those.
 class Events {
  public:
   enum class QueueRule { AllowDuplicates, NoDuplicates };
 
+  static constexpr size_t kCapacity = 256;
+
   Events() = default;
 
   Events(const Events&) = delete;
 
   Events(const Events&&) noexcept = delete;
 
-  void Push(Event::Type type, QueueRule queue_rule = QueueRule::AllowDuplicates) {
-    if (Event::Type::None == type) {
-      return;
+  // Returns false if the queue is full and the event was dropped. NoDuplicates removes any
+  // queued event of the same type first, so only the newest one is kept.
+  bool Push(const Event& event, QueueRule queue_rule = QueueRule::AllowDuplicates) {
+    if (Event::Type::None == event.type_) {
+      return true;
     }
     if (QueueRule::NoDuplicates == queue_rule) {
-      Remove(type);
+      Remove(event.type_);
+    }
+    if (!Reserve()) {
+      return false;
     }
-    events_.emplace_back(type);
+    Store(tail_++, event);
+
+    return true;
   }
 
-  template<class ...Args>
-  void Push(Args&&... args) { events_.emplace_back(std::forward<Args>(args)...); }
+  inline bool Push(Event::Type type, QueueRule queue_rule = QueueRule::AllowDuplicates) {
+    return Push(Event(type), queue_rule);
+  }
 
-  inline void PushFront(Event::Type type) { events_.emplace_front(type); }
+  template<typename T>
+  inline bool Push(Event::Type type, const T& payload, QueueRule queue_rule = QueueRule::AllowDuplicates) {
+    return Push(Event(type, payload), queue_rule);
+  }
 
-  inline void Remove(Event::Type type) { events_.erase(std::remove(events_.begin(), events_.end(), type), events_.end()); }
+  bool PushFront(const Event& event) {
+    if (Event::Type::None == event.type_) {
+      return true;
+    }
+    if (!Reserve()) {
+      return false;
+    }
+    Store(--head_, event);
 
+    return true;
+  }
+
+  inline bool PushFront(Event::Type type) { return PushFront(Event(type)); }
+
+  void Remove(Event::Type type) {
+    const auto index = static_cast<size_t>(type);
+
+    size_ -= counts_[index];
+    counts_[index] = 0;
+    present_ &= ~Bit(type);
+    removed_before_[index] = sequence_;
+  }
+
+  // Returns a None event if the queue is empty
   Event Pop() {
-    auto event = events_.front();
+    while (head_ != tail_) {
+      const auto& slot = slots_[head_++ & kMask];
+
+      if (IsLive(slot)) {
+        const auto index = static_cast<size_t>(slot.event.type_);
+
+        size_--;
+        if (0 == --counts_[index]) {
+          present_ &= ~Bit(slot.event.type_);
+        }
+        return slot.event;
+      }
+    }
+    return Event();
+  }
+
+  // Pops every queued event and hands it to the listeners subscribed to its type, events pushed
+  // by a listener are dispatched in the same call. Listeners may subscribe and unsubscribe from
+  // Update, a listener subscribed there gets the events after the one being dispatched.
+  void Dispatch() {
+    dispatching_++;
+    while (!IsEmpty()) {
+      const auto event = Pop();
+      const auto& subscribers = subscribers_[static_cast<size_t>(event.type_)];
+      const auto count = subscribers.size();
+
+      for (size_t i = 0; i < count; ++i) {
+        if (auto listener = subscribers[i]) {
+          listener->Update(event);
+        }
+      }
+    }
+    if (0 == --dispatching_) {
+      for (auto& subscribers : subscribers_) {
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), nullptr), subscribers.end());
+      }
+    }
+  }
 
-    events_.pop_front();
+  void Subscribe(EventListener* listener, const std::initializer_list<Event::Type>& types) {
+    for (auto type : types) {
+      auto& subscribers = subscribers_[static_cast<size_t>(type)];
+
+      if (std::find(subscribers.begin(), subscribers.end(), listener) == subscribers.end()) {
+        subscribers.push_back(listener);
+      }
+    }
+  }
+
+  // While dispatching the listener is only cleared, the lists are compacted when dispatch ends
+  void Unsubscribe(EventListener* listener) {
+    for (auto& subscribers : subscribers_) {
+      if (dispatching_ > 0) {
+        std::replace(subscribers.begin(), subscribers.end(), listener, static_cast<EventListener*>(nullptr));
+      } else {
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), listener), subscribers.end());
+      }
+    }
+  }
 
-    return event;
+  void Clear() {
+    head_ = tail_ = 0;
+    size_ = 0;
+    present_ = 0;
+    counts_ = {};
   }
 
-  void Clear() { events_.clear(); }
+  inline bool Contains(Event::Type type) const { return 0 != (present_ & Bit(type)); }
+
+  inline bool IsEmpty() const { return 0 == size_; }
 
-  inline bool IsEmpty() const { return events_.empty(); }
+  inline size_t size() const { return size_; }
+
+ protected:
+  struct Slot {
+    Event event;
+    uint64_t sequence;
+  };
+
+  static constexpr size_t kMask = kCapacity - 1;
+
+  static inline uint64_t Bit(Event::Type type) { return uint64_t(1) << static_cast<size_t>(type); }
+
+  inline bool IsLive(const Slot& slot) const {
+    return slot.sequence >= removed_before_[static_cast<size_t>(slot.event.type_)];
+  }
+
+  // Makes room for one more event. Removed events at the front are dropped right away, the
+  // ones further in are only squeezed out when the ring is full.
+  bool Reserve() {
+    while (head_ != tail_ && !IsLive(slots_[head_ & kMask])) {
+      head_++;
+    }
+    if (tail_ - head_ == kCapacity && size_ < kCapacity) {
+      Compact();
+    }
+    return tail_ - head_ < kCapacity;
+  }
+
+  void Compact() {
+    auto position = head_;
+
+    for (auto i = head_; i != tail_; ++i) {
+      if (IsLive(slots_[i & kMask])) {
+        slots_[position++ & kMask] = slots_[i & kMask];
+      }
+    }
+    tail_ = position;
+  }
+
+  void Store(size_t position, const Event& event) {
+    const auto index = static_cast<size_t>(event.type_);
+
+    slots_[position & kMask] = { event, sequence_++ };
+    size_++;
+    counts_[index]++;
+    present_ |= Bit(event.type_);
+  }
 
  private:
-  std::deque<Event> events_;
+  static_assert((kCapacity & kMask) == 0, "Capacity must be a power of two");
+  static_assert(Event::kTypeCount <= 64, "Every type needs a bit in the presence mask");
+
+  std::array<Slot, kCapacity> slots_;
+  size_t head_ = 0;
+  size_t tail_ = 0;
+  size_t size_ = 0;
+  uint64_t sequence_ = 0;
+  uint64_t present_ = 0;
+  std::array<uint32_t, Event::kTypeCount> counts_ = {};
+  std::array<uint64_t, Event::kTypeCount> removed_before_ = {};
+  std::array<std::vector<EventListener*>, Event::kTypeCount> subscribers_;
+  // Nested Dispatch() calls, listeners are not erased while it is above zero
+  int dispatching_ = 0;
 };
@@ -0,0 +1,277 @@
+#include "game/flood_fill.h"
+#include "utility/bits.h"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+using namespace utility;
+
+// Sets bit x1 to x2 (inclusive) in a row of the mask. Long spans are written with
+// AVX2/SSE2 stores, the mask is one bit per cell so a 128-bit store covers 128 cells.
+void SetBits(uint64_t* row, int x1, int x2) {
+  const int first = x1 / FloodFill::kCellsPerChunk;
+  const int last = x2 / FloodFill::kCellsPerChunk;
+  const uint64_t first_mask = ~0ull << (x1 % FloodFill::kCellsPerChunk);
+  const uint64_t last_mask = ~0ull >> (FloodFill::kCellsPerChunk - 1 - x2 % FloodFill::kCellsPerChunk);
+
+  if (first == last) {
+    row[first] |= first_mask & last_mask;
+    return;
+  }
+  row[first] |= first_mask;
+
+  int chunk = first + 1;
+
+#if defined(__AVX2__)
+  const __m256i ones_256 = _mm256_set1_epi32(-1);
+
+  for (; chunk + 4 <= last; chunk += 4) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + chunk), ones_256);
+  }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+  const __m128i ones_128 = _mm_set1_epi32(-1);
+
+  for (; chunk + 2 <= last; chunk += 2) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(row + chunk), ones_128);
+  }
+#endif
+  for (; chunk < last; ++chunk) {
+    row[chunk] = ~0ull;
+  }
+  row[last] |= last_mask;
+}
+
+// A packed grid word holds 32 cells, a chunk of 64 cells is built from two of them
+inline uint64_t CompactCells(const Grid& grid, const uint64_t* row, int chunk, uint64_t (*select)(uint64_t)) {
+  const int word = chunk * 2;
+  uint64_t cells = CompactEvenBits(select(row[word]));
+
+  if (word + 1 < grid.words_per_row()) {
+    cells |= CompactEvenBits(select(row[word + 1])) << 32;
+  }
+  return cells;
+}
+
+inline uint64_t IsOccupied(uint64_t word) { return word | (word >> 1); }
+
+inline uint64_t IsEdge(uint64_t word) { return (word >> 1) & ~word; }
+
+// Writes the cells of a chunk back into the two packed words it was built from
+inline void XorCells(const Grid& grid, uint64_t* row, int chunk, uint64_t cells, uint64_t pattern) {
+  const int word = chunk * 2;
+
+  row[word] ^= SpreadToEvenBits(cells) * pattern;
+  if (word + 1 < grid.words_per_row()) {
+    row[word + 1] ^= SpreadToEvenBits(cells >> 32) * pattern;
+  }
+}
+
+// Unclaimed (00) ^ 01 -> Claimed (01), Edge (10) ^ 11 -> Claimed (01)
+const uint64_t kUnclaimedToClaimed = 1;
+const uint64_t kEdgeToClaimed = 3;
+
+}  // namespace
+
+FloodFill::FloodFill(int width, int height)
+    : width_(width), height_(height), chunks_per_row_((width + kCellsPerChunk - 1) / kCellsPerChunk),
+      last_chunk_mask_((width % kCellsPerChunk) ? (1ull << (width % kCellsPerChunk)) - 1 : ~0ull),
+      unclaimed_(static_cast<size_t>(chunks_per_row_) * height, 0),
+      mask_(static_cast<size_t>(chunks_per_row_) * height, 0),
+      claimed_(static_cast<size_t>(chunks_per_row_) * height, 0) {
+  stack_.reserve(height * 4);
+}
+
+void FloodFill::UnpackUnclaimed(const Grid& grid) {
+  for (int y = 0; y < height_; ++y) {
+    const auto row = grid.row(y);
+
+    for (int chunk = 0; chunk < chunks_per_row_; ++chunk) {
+      uint64_t occupied = CompactCells(grid, row, chunk, IsOccupied);
+
+      if (chunk * 2 + 1 >= grid.words_per_row()) {
+        occupied |= 0xffffffff00000000ull;
+      }
+      unclaimed_[index(y, chunk)] = ~occupied;
+    }
+    unclaimed_[index(y, chunks_per_row_ - 1)] &= last_chunk_mask_;
+  }
+}
+
+int FloodFill::ScanLeft(int x, int y) const {
+  int chunk = x / kCellsPerChunk;
+  int bit = x % kCellsPerChunk;
+
+  while (true) {
+    // Bits shifted in from below count as closed, so n never exceeds bit + 1
+    const uint64_t closed = ~(Open(y, chunk) << (kCellsPerChunk - 1 - bit));
+    const int n = (0 == closed) ? kCellsPerChunk : CountLeadingZeros(closed);
+
+    if (n < bit + 1 || 0 == chunk) {
+      return chunk * kCellsPerChunk + bit - n + 1;
+    }
+    chunk--;
+    bit = kCellsPerChunk - 1;
+  }
+}
+
+int FloodFill::ScanRight(int x, int y) const {
+  int chunk = x / kCellsPerChunk;
+  int bit = x % kCellsPerChunk;
+
+  while (true) {
+    const uint64_t closed = ~(Open(y, chunk) >> bit);
+    const int n = (0 == closed) ? kCellsPerChunk : CountTrailingZeros(closed);
+
+    if (n < kCellsPerChunk - bit || chunk + 1 == chunks_per_row_) {
+      return chunk * kCellsPerChunk + bit + n - 1;
+    }
+    chunk++;
+    bit = 0;
+  }
+}
+
+// Pushes one seed for every run of open cells between x1 and x2 on row y
+void FloodFill::PushSpans(int x1, int x2, int y) {
+  const int first = x1 / kCellsPerChunk;
+  const int last = x2 / kCellsPerChunk;
+  uint64_t carry = 0;
+
+  for (int chunk = first; chunk <= last; ++chunk) {
+    uint64_t open = Open(y, chunk);
+
+    if (chunk == first) {
+      open &= ~0ull << (x1 % kCellsPerChunk);
+    }
+    if (chunk == last) {
+      open &= ~0ull >> (kCellsPerChunk - 1 - x2 % kCellsPerChunk);
+    }
+    uint64_t starts = open & ~((open << 1) | carry);
+
+    carry = open >> (kCellsPerChunk - 1);
+    while (starts) {
+      stack_.push_back({ chunk * kCellsPerChunk + CountTrailingZeros(starts), y });
+      starts &= starts - 1;
+    }
+  }
+}
+
+size_t FloodFill::Fill(const Grid& grid, int x, int y) {
+  std::fill(mask_.begin(), mask_.end(), 0);
+  claimed_rows_ = { 0, -1 };
+  UnpackUnclaimed(grid);
+  if (!grid.IsInside(x, y) || !IsOpen(x, y)) {
+    return 0;
+  }
+  size_t marked = 0;
+
+  stack_.clear();
+  stack_.push_back({ x, y });
+  while (!stack_.empty()) {
+    const auto seed = stack_.back();
+
+    stack_.pop_back();
+    if (!IsOpen(seed.x, seed.y)) {
+      continue;
+    }
+    const int x1 = ScanLeft(seed.x, seed.y);
+    const int x2 = ScanRight(seed.x, seed.y);
+
+    SetBits(mask_row(seed.y), x1, x2);
+    marked += x2 - x1 + 1;
+    if (seed.y > 0) {
+      PushSpans(x1, x2, seed.y - 1);
+    }
+    if (seed.y < height_ - 1) {
+      PushSpans(x1, x2, seed.y + 1);
+    }
+  }
+  return marked;
+}
+
+size_t FloodFill::ClaimUnmarked(Grid& grid) {
+  size_t claimed = 0;
+  int y1 = height_;
+  int y2 = -1;
+
+  for (int y = 0; y < height_; ++y) {
+    auto row = grid.row(y);
+    size_t claimed_in_row = 0;
+
+    for (int chunk = 0; chunk < chunks_per_row_; ++chunk) {
+      const uint64_t open = Open(y, chunk);
+
+      claimed_[index(y, chunk)] = open;
+      if (0 == open) {
+        continue;
+      }
+      XorCells(grid, row, chunk, open, kUnclaimedToClaimed);
+      unclaimed_[index(y, chunk)] ^= open;
+      claimed_in_row += PopCount(open);
+    }
+    if (claimed_in_row > 0) {
+      claimed += claimed_in_row;
+      y1 = std::min(y1, y);
+      y2 = y;
+    }
+  }
+  if (0 == claimed) {
+    return 0;
+  }
+  // Only edges next to a claimed cell can have lost their last unclaimed neighbour
+  y1 = std::max(0, y1 - 1);
+  y2 = std::min(height_ - 1, y2 + 1);
+  claimed += ClaimEnclosedEdges(grid, y1, y2);
+  claimed_rows_ = { y1, y2 };
+  grid.MarkDirty(0, y1, width_, y2 - y1 + 1);
+
+  return claimed;
+}
+
+size_t FloodFill::ClaimEnclosedEdges(Grid& grid, int y1, int y2) {
+  size_t claimed = 0;
+
+  for (int y = y1; y <= y2; ++y) {
+    auto row = grid.row(y);
+    auto unclaimed_around = [this, y](int chunk) {
+      if (chunk >= chunks_per_row_) {
+        return uint64_t(0);
+      }
+      uint64_t unclaimed = unclaimed_[index(y, chunk)];
+
+      if (y > 0) {
+        unclaimed |= unclaimed_[index(y - 1, chunk)];
+      }
+      if (y < height_ - 1) {
+        unclaimed |= unclaimed_[index(y + 1, chunk)];
+      }
+      return unclaimed;
+    };
+    uint64_t previous = 0;
+    uint64_t current = unclaimed_around(0);
+
+    for (int chunk = 0; chunk < chunks_per_row_; ++chunk) {
+      const uint64_t next = unclaimed_around(chunk + 1);
+      const uint64_t near = current | (current << 1) | (current >> 1) | (previous >> (kCellsPerChunk - 1)) |
+                            (next << (kCellsPerChunk - 1));
+      const uint64_t enclosed = CompactCells(grid, row, chunk, IsEdge) & ~near;
+
+      if (enclosed) {
+        XorCells(grid, row, chunk, enclosed, kEdgeToClaimed);
+        claimed_[index(y, chunk)] |= enclosed;
+        claimed += PopCount(enclosed);
+      }
+      previous = current;
+      current = next;
+    }
+  }
+  return claimed;
+}
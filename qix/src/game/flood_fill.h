@@ -0,0 +1,88 @@
+#pragma once
+
+#include "game/grid.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+// Claims area once the player has closed a stix. The unclaimed cells of the grid are first
+// unpacked into a bitset with one bit per cell. The region holding the Qix is then flood
+// filled, scanline by scanline, into a mask of the same layout and every unclaimed cell
+// outside of that mask is claimed with a word-parallel pass over the grid.
+class FloodFill final {
+ public:
+  static constexpr int kCellsPerChunk = 64;
+
+  FloodFill(int width, int height);
+
+  FloodFill(const FloodFill&) = delete;
+
+  FloodFill(const FloodFill&&) = delete;
+
+  // Marks every unclaimed cell 4-connected to x, y. Returns the number of marked cells,
+  // zero if x, y is not an unclaimed cell.
+  size_t Fill(const Grid& grid, int x, int y);
+
+  // Claims every unclaimed cell not marked by the last fill, which must have been made on
+  // the same grid. Edges that no longer border any unclaimed cell are claimed as well.
+  // Returns the number of claimed cells.
+  size_t ClaimUnmarked(Grid& grid);
+
+  // Claims everything on the other side of the stix than the Qix, returns zero and leaves
+  // the grid untouched if the Qix is not on an unclaimed cell
+  size_t Claim(Grid& grid, int qix_x, int qix_y) {
+    return (Fill(grid, qix_x, qix_y) > 0) ? ClaimUnmarked(grid) : 0;
+  }
+
+  inline bool IsMarked(int x, int y) const { return (mask_row(y)[x / kCellsPerChunk] >> (x % kCellsPerChunk)) & 1; }
+
+  // The cells claimed by the last claim, one bit per cell. Only rows in claimed_rows() can have any bit set.
+  inline const uint64_t* claimed_row(int y) const { return &claimed_[index(y, 0)]; }
+
+  inline std::pair<int, int> claimed_rows() const { return claimed_rows_; }
+
+  inline int chunks_per_row() const { return chunks_per_row_; }
+
+ protected:
+  void UnpackUnclaimed(const Grid& grid);
+
+  // Bit n is set if cell chunk * 64 + n is unclaimed and not yet marked
+  inline uint64_t Open(int y, int chunk) const {
+    const auto i = index(y, chunk);
+
+    return unclaimed_[i] & ~mask_[i];
+  }
+
+  inline bool IsOpen(int x, int y) const { return (Open(y, x / kCellsPerChunk) >> (x % kCellsPerChunk)) & 1; }
+
+  int ScanLeft(int x, int y) const;
+
+  int ScanRight(int x, int y) const;
+
+  void PushSpans(int x1, int x2, int y);
+
+  size_t ClaimEnclosedEdges(Grid& grid, int y1, int y2);
+
+  inline size_t index(int y, int chunk) const { return static_cast<size_t>(y) * chunks_per_row_ + chunk; }
+
+  inline const uint64_t* mask_row(int y) const { return &mask_[index(y, 0)]; }
+
+  inline uint64_t* mask_row(int y) { return &mask_[index(y, 0)]; }
+
+ private:
+  struct Seed {
+    int x;
+    int y;
+  };
+
+  int width_;
+  int height_;
+  int chunks_per_row_;
+  uint64_t last_chunk_mask_;
+  std::vector<uint64_t> unclaimed_;
+  std::vector<uint64_t> mask_;
+  std::vector<uint64_t> claimed_;
+  std::pair<int, int> claimed_rows_ = { 0, -1 };
+  std::vector<Seed> stack_;
+};
@@ -0,0 +1,45 @@
+#include "game/grid.h"
+
+#include <algorithm>
+
+Grid::Grid(int width, int height)
+    : width_(width), height_(height), words_per_row_((width + kCellsPerWord - 1) / kCellsPerWord),
+      cells_(static_cast<size_t>(words_per_row_) * height, 0), tiles_y_((height + kTileSize - 1) / kTileSize),
+      tile_words_per_row_(((width + kTileSize - 1) / kTileSize + 63) / 64),
+      dirty_tiles_(static_cast<size_t>(tile_words_per_row_) * tiles_y_, 0) {
+  Reset();
+}
+
+void Grid::Reset() {
+  std::fill(cells_.begin(), cells_.end(), 0);
+  for (int x = 0; x < width_; ++x) {
+    Set(x, 0, Cell::Edge);
+    Set(x, height_ - 1, Cell::Edge);
+  }
+  for (int y = 0; y < height_; ++y) {
+    Set(0, y, Cell::Edge);
+    Set(width_ - 1, y, Cell::Edge);
+  }
+  MarkDirty(0, 0, width_, height_);
+}
+
+void Grid::MarkDirty(int x, int y, int w, int h) {
+  if (w <= 0 || h <= 0) {
+    return;
+  }
+  const int tx2 = (x + w - 1) / kTileSize;
+  const int ty2 = (y + h - 1) / kTileSize;
+
+  for (int ty = y / kTileSize; ty <= ty2; ++ty) {
+    for (int tx = x / kTileSize; tx <= tx2; ++tx) {
+      MarkTileDirty(tx, ty);
+    }
+  }
+}
+
+void Grid::ClearDirty() {
+  if (dirty_) {
+    std::fill(dirty_tiles_.begin(), dirty_tiles_.end(), 0);
+    dirty_ = false;
+  }
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "utility/bits.h"
+
+#include <SDL.h>
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// The authoritative model of the playfield. Each cell is packed into 2 bits, so a row
+// of kPlayFieldWidth cells is only a handful of 64-bit words. The texture shown on screen
+// is derived from this model, never the other way around. Changes are tracked per tile of
+// kTileSize x kTileSize cells, only those tiles are uploaded to the texture.
+class Grid final {
+ public:
+  enum class Cell : uint8_t { Unclaimed = 0, Claimed = 1, Edge = 2, Stix = 3 };
+
+  static constexpr int kBitsPerCell = 2;
+  static constexpr int kCellsPerWord = 64 / kBitsPerCell;
+  static constexpr uint64_t kCellMask = 0x3;
+  static constexpr int kTileSize = 32;
+
+  Grid(int width, int height);
+
+  // All cells unclaimed, enclosed by an edge along the border of the grid
+  void Reset();
+
+  inline bool IsInside(int x, int y) const { return x >= 0 && y >= 0 && x < width_ && y < height_; }
+
+  inline Cell Get(int x, int y) const {
+    return static_cast<Cell>((row(y)[x / kCellsPerWord] >> Shift(x)) & kCellMask);
+  }
+
+  inline void Set(int x, int y, Cell cell) {
+    auto& word = row(y)[x / kCellsPerWord];
+
+    word = (word & ~(kCellMask << Shift(x))) | (static_cast<uint64_t>(cell) << Shift(x));
+    MarkTileDirty(x / kTileSize, y / kTileSize);
+  }
+
+  // Marks every tile overlapping the given area as changed
+  void MarkDirty(int x, int y, int w, int h);
+
+  void ClearDirty();
+
+  inline bool IsDirty() const { return dirty_; }
+
+  // Calls function with a rectangle for every horizontal run of changed tiles, clipped to the grid
+  template<typename Function>
+  void ForEachDirtySpan(Function function) const {
+    for (int ty = 0; ty < tiles_y_; ++ty) {
+      for (int i = 0; i < tile_words_per_row_; ++i) {
+        uint64_t bits = dirty_tiles_[static_cast<size_t>(ty) * tile_words_per_row_ + i];
+
+        while (0 != bits) {
+          const int first = utility::CountTrailingZeros(bits);
+          const uint64_t rest = ~(bits >> first);
+          const int count = (0 == rest) ? 64 : utility::CountTrailingZeros(rest);
+          const int x = (i * 64 + first) * kTileSize;
+          const int y = ty * kTileSize;
+
+          function(SDL_Rect{ x, y, std::min(count * kTileSize, width_ - x), std::min(kTileSize, height_ - y) });
+          bits &= (64 == first + count) ? 0 : ~0ull << (first + count);
+        }
+      }
+    }
+  }
+
+  inline size_t dirty_tiles() const {
+    size_t count = 0;
+
+    for (auto bits : dirty_tiles_) {
+      count += utility::PopCount(bits);
+    }
+    return count;
+  }
+
+  inline const uint64_t* row(int y) const { return &cells_[static_cast<size_t>(y) * words_per_row_]; }
+
+  inline uint64_t* row(int y) { return &cells_[static_cast<size_t>(y) * words_per_row_]; }
+
+  inline int words_per_row() const { return words_per_row_; }
+
+  inline int width() const { return width_; }
+
+  inline int height() const { return height_; }
+
+ protected:
+  static inline int Shift(int x) { return (x % kCellsPerWord) * kBitsPerCell; }
+
+  inline void MarkTileDirty(int tx, int ty) {
+    dirty_tiles_[static_cast<size_t>(ty) * tile_words_per_row_ + tx / 64] |= 1ull << (tx % 64);
+    dirty_ = true;
+  }
+
+ private:
+  int width_;
+  int height_;
+  int words_per_row_;
+  std::vector<uint64_t> cells_;
+  int tiles_y_;
+  int tile_words_per_row_;
+  // One bit per tile
+  std::vector<uint64_t> dirty_tiles_;
+  bool dirty_ = false;
+};
@@ -0,0 +1,21 @@
+#include "game/input.h"
+
+void Input::Reset() {
+  Event event;
+
+  while (queue_.TryPop(event)) {}
+  has_pending_ = false;
+  active_ = Controls::None;
+}
+
+bool Input::IsRepeatable(Controls control) {
+  switch (control) {
+    case Controls::Left:
+    case Controls::Right:
+    case Controls::Up:
+    case Controls::Down:
+      return true;
+    default:
+      return false;
+  }
+}
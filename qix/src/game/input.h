@@ -0,0 +1,89 @@
+#pragma once
+
+#include "game/playfield.h"
+#include "utility/spsc_queue.h"
+
+#include <chrono>
+#include <limits>
+#include <algorithm>
+
+// Hands controls from the thread that reads SDL events to the logic step. Every press and
+// release carries the time it happened, and the logic step consumes them tick by tick so a
+// control takes effect on the tick it was pressed in. Auto repeat (DAS) runs on the same
+// clock, repeats fire on the first tick after they are due instead of on a frame boundary.
+class Input final {
+ public:
+  using Controls = Playfield::Controls;
+  using HighResClock = std::chrono::high_resolution_clock;
+
+  struct Event {
+    Controls control;
+    bool pressed;
+    double time;
+  };
+
+  Input() : epoch_(HighResClock::now()) {}
+
+  Input(const Input&) = delete;
+
+  // Seconds since the input was created
+  inline double Now() const { return std::chrono::duration<double>(HighResClock::now() - epoch_).count(); }
+
+  // Producer side, returns false if the queue is full and the event was dropped
+  inline bool Push(Controls control, bool pressed, double time) { return queue_.TryPush({ control, pressed, time }); }
+
+  // Consumer side, calls apply for every control due at or before time, in time order,
+  // repeats included
+  template<typename Function>
+  void Process(double time, Function apply) {
+    while (true) {
+      if (!has_pending_) {
+        has_pending_ = queue_.TryPop(pending_);
+      }
+      const double event_time = has_pending_ ? pending_.time : kNever;
+      const double repeat_time = IsRepeatable(active_) ? next_repeat_ : kNever;
+
+      if (std::min(event_time, repeat_time) > time) {
+        return;
+      }
+      if (repeat_time < event_time) {
+        apply(active_);
+        next_repeat_ += kAutoRepeatSubsequentDelay;
+        continue;
+      }
+      has_pending_ = false;
+      Handle(pending_, apply);
+    }
+  }
+
+  void Reset();
+
+  static bool IsRepeatable(Controls control);
+
+ protected:
+  template<typename Function>
+  void Handle(const Event& event, Function apply) {
+    if (!event.pressed) {
+      if (event.control == active_) {
+        active_ = Controls::None;
+      }
+      return;
+    }
+    // Any other control stops the current auto repeat
+    active_ = event.control;
+    next_repeat_ = event.time + kAutoRepeatInitialDelay;
+    apply(event.control);
+  }
+
+ private:
+  static constexpr double kNever = std::numeric_limits<double>::infinity();
+  static constexpr double kAutoRepeatInitialDelay = 0.3; // seconds
+  static constexpr double kAutoRepeatSubsequentDelay = 0.05; // seconds
+
+  HighResClock::time_point epoch_;
+  utility::SpscQueue<Event, 256> queue_;
+  Event pending_ = {};
+  bool has_pending_ = false;
+  Controls active_ = Controls::None;
+  double next_repeat_ = 0.0;
+};
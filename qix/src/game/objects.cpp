@@ -0,0 +1,82 @@
+#include "game/objects.h"
+
+#include <cmath>
+#include <array>
+#include <algorithm>
+
+namespace {
+
+const float kPiDiv180 = static_cast<float>(M_PI / 180.0);
+const float kSpeed = 150.0f; // pixels per second
+// Most the heading drifts at random and turns away from a wall, degrees per second
+const float kWanderRate = 360.0f;
+const float kSteerRate = 540.0f;
+// Closer than this to a wall the Qix starts to turn away
+const float kWallMargin = 48.0f; // pixels
+// Spread of the heading bouncing off a wall, degrees
+const float kBounce = 45.0f;
+const int kTrailTicks = 6;
+const int kMinLength = 40;
+const int kMaxLength = 120;
+const std::array<utility::Color, 3> kColors = { utility::Color::Red, utility::Color::Green, utility::Color::Blue };
+
+// -180 to 180 degrees
+float Wrap(float angle) {
+  angle = std::fmod(angle + 180.0f, 360.0f);
+
+  return (angle < 0.0f ? angle + 360.0f : angle) - 180.0f;
+}
+
+}  // namespace
+
+QixObject::QixObject(int start_x, int start_y, uint64_t seed) : lines_(kQixLines), random_(seed) {
+  heading_ = random_.Uniform(-180.0f, 180.0f);
+  lines_.Add(static_cast<float>(start_x), static_cast<float>(start_y), static_cast<int>(std::lround(heading_)),
+             static_cast<int>(random_.Uniform(kMinLength, kMaxLength)), kSpeed, kColors[color_]);
+}
+
+void QixObject::Update(double delta, const DistanceField& field) {
+  const int head = lines_.size() - 1;
+  const float x = lines_.x(head);
+  const float y = lines_.y(head);
+  const float d = static_cast<float>(delta);
+  const float distance = field.Distance(x, y);
+
+  heading_ += random_.Uniform(-kWanderRate * d, kWanderRate * d);
+  if (distance < kWallMargin) {
+    float gx = 0.0f;
+    float gy = 0.0f;
+
+    field.Gradient(x, y, gx, gy);
+    if (0.0f != gx || 0.0f != gy) {
+      // Screen y grows downwards
+      const float away = std::atan2(-gy, gx) / kPiDiv180;
+      const float step = kSpeed * d;
+      const float heading = heading_ * kPiDiv180;
+
+      if (field.IsBlocked(x + std::cos(heading) * step, y - std::sin(heading) * step)) {
+        heading_ = away + random_.Uniform(-kBounce, kBounce);
+      } else {
+        // The closer the wall the harder it turns
+        const float limit = kSteerRate * d * (1.0f - distance / kWallMargin);
+
+        heading_ += std::clamp(Wrap(away - heading_), -limit, limit);
+      }
+    }
+  }
+  heading_ = Wrap(heading_);
+  lines_.SetDirection(head, static_cast<int>(std::lround(heading_)));
+  lines_.Update(delta);
+  if (0 != ++ticks_ % kTrailTicks) {
+    return;
+  }
+  // The leading line stays behind and a copy of it takes the lead
+  lines_.Advance();
+
+  const int lead = lines_.size() - 1;
+
+  color_ = (color_ + 1) % kColors.size();
+  lines_.SetVelocity(lead - 1, 0.0f);
+  lines_.SetColor(lead, kColors[color_]);
+  lines_.SetLength(lead, static_cast<int>(random_.Uniform(kMinLength, kMaxLength)));
+}
@@ -2,43 +2,92 @@
 #include "game/playfield.h"
 #include "utility/timer.h"
 
+#include <array>
 #include <iostream>
 #include <memory>
+#include <cstdlib>
+#include <algorithm>
 
 namespace {
 
-void ClearTexture(SDL_Renderer* renderer, SDL_Texture* texture) {
-  SDL_SetRenderTarget(renderer, texture);
-  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-  SDL_RenderClear(renderer);
-  SDL_SetRenderTarget(renderer, nullptr);
-}
+const SDL_Rect kPlayFieldRect = { 0, 0, kPlayFieldWidth, kPlayFieldHeight };
+const int kPlayerStartX = kPlayFieldWidth / 2;
+const int kPlayerStartY = kPlayFieldHeight - 1;
+const size_t kMaxQix = 2;
+const size_t kMaxEntities = 256;
+const size_t kMaxSparx = 32;
+const double kSparxSpeed = 60.0; // cells per second
+const int kSparxSize = 8;
+const size_t kStixCapacity = 4 * (kPlayFieldWidth + kPlayFieldHeight);
+// The logic and the renderer have a thread each, rasterizing gets a few cores to itself
+const size_t kMaxRasterWorkers = 4;
+
+const int kClaimedHatchSpacing = 8;
+
+// Claimed area is blue with diagonal hatch lines
+const std::array<utility::Rasterizer::Pattern, 4> kCellPatterns = {{
+  { utility::ToRGBA8888(utility::Color::Black) }, // Unclaimed
+  { utility::ToRGBA8888(utility::Color::Blue), utility::ToRGBA8888(utility::Color::SteelGray), kClaimedHatchSpacing },
+  { utility::ToRGBA8888(utility::Color::White) }, // Edge
+  { utility::ToRGBA8888(utility::Color::Red) } // Stix
+}};
 
-void DrawPixel(SDL_Renderer* renderer, SDL_Texture* texture, int x, int y) {
-  SDL_SetRenderDrawColor(renderer, 255, 0, 0, 0);
-  SDL_SetRenderTarget(renderer, texture);
-  SDL_RenderDrawPoint(renderer, x, y);
-  SDL_SetRenderTarget(renderer, nullptr);
 }
 
-void RenderObjects(std::deque<std::shared_ptr<Object>>& objects, double delta_time) {
-  for (auto it = objects.begin(); it != objects.end();) {
-    (*it)->Render(delta_time);
-    /*if (auto [status, event] = (*it)->IsReady(); status) {
-      events.Push(event);
-      it = animations.erase(it);
-    } else {
-      ++it;
-      }*/
-    ++it;
+using namespace utility;
+
+Playfield::Playfield(Backend backend)
+    : backend_(backend), grid_(kPlayFieldWidth, kPlayFieldHeight), border_(kPlayFieldWidth, kPlayFieldHeight),
+      flood_fill_(kPlayFieldWidth, kPlayFieldHeight), distance_field_(kPlayFieldWidth, kPlayFieldHeight),
+      claim_tracker_(kPlayFieldWidth, kPlayFieldHeight), collision_(kPlayFieldWidth, kPlayFieldHeight),
+      x_(kPlayerStartX), y_(kPlayerStartY), seed_(kDefaultSeed), qix_objects_(kMaxQix),
+      entities_(kMaxEntities) {
+  switch (backend_) {
+    case Backend::Window:
+      CreateWindowRenderer();
+      break;
+    case Backend::Software:
+      CreateSoftwareRenderer();
+      break;
+    case Backend::Null:
+      break;
+  }
+  if (nullptr != renderer_) {
+    surface_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, kPlayFieldWidth, kPlayFieldHeight);
+    jobs_ = std::make_unique<JobSystem>(std::min(kMaxRasterWorkers, JobSystem::PhysicalCores().size()));
+    rasterizer_ = std::make_unique<Rasterizer>(kPlayFieldWidth, kPlayFieldHeight, kCellPatterns, *jobs_);
+    spans_.reserve(static_cast<size_t>(kPlayFieldHeight / Grid::kTileSize + 1) * kPlayFieldWidth / Grid::kTileSize);
+    fonts_ = std::make_shared<Fonts>();
+    atlas_ = std::make_shared<GlyphAtlas>(renderer_, fonts_);
+    hud_ = std::make_unique<PerfHud>(renderer_, atlas_);
+    command_renderer_ = std::make_unique<CommandRenderer>(renderer_, atlas_);
   }
+  stix_.reserve(kStixCapacity);
+  sparx_.reserve(kMaxSparx);
+  distance_field_.Build(grid_);
+  ResetObjects();
 }
 
+Playfield::~Playfield() noexcept {
+  qix_objects_.Reset();
+  command_renderer_.reset();
+  hud_.reset();
+  atlas_.reset();
+  if (nullptr != surface_) {
+    SDL_DestroyTexture(surface_);
+  }
+  if (nullptr != renderer_) {
+    SDL_DestroyRenderer(renderer_);
+  }
+  if (nullptr != canvas_) {
+    SDL_FreeSurface(canvas_);
+  }
+  if (nullptr != window_) {
+    SDL_DestroyWindow(window_);
+  }
 }
 
-using namespace utility;
-
-Playfield::Playfield() {
+void Playfield::CreateWindowRenderer() {
   window_ = SDL_CreateWindow("", SDL_WINDOWPOS_UNDEFINED,
                              SDL_WINDOWPOS_UNDEFINED, kWidth, kHeight, SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
   if (nullptr == window_) {
@@ -46,6 +95,11 @@ Playfield::Playfield() {
     exit(-1);
   }
   renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+  if (nullptr == renderer_) {
+    // The playfield is rasterized on the CPU anyway, a software renderer only has to copy it
+    std::cout << "No accelerated renderer (" << SDL_GetError() << "), using the software renderer" << std::endl;
+    renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_SOFTWARE);
+  }
   if (nullptr == renderer_) {
     std::cout << "Failed to create renderer : " << SDL_GetError() << std::endl;
     exit(-1);
@@ -54,88 +108,296 @@ Playfield::Playfield() {
     std::cout << "Failed to set logical size : " << SDL_GetError() << std::endl;
     exit(-1);
   }
-  surface_ = SDL_CreateTexture(renderer_, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, kWidth, kHeight);
-  ClearTexture(renderer_, surface_);
-
   SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
   game_controller_ = std::make_shared<utility::GameController>(kAssetFolder);
   SDL_RaiseWindow(window_);
-  // AddObject<LineDraw>(renderer_, kWidth / 2, kHeight / 2, direction_, 100, 0, Color::Red);
-  AddObject<QixObject>(renderer_, 0, kHeight / 2);
 }
 
-Playfield::~Playfield() noexcept {
-  SDL_DestroyRenderer(renderer_);
-  SDL_DestroyWindow(window_);
+void Playfield::CreateSoftwareRenderer() {
+  canvas_ = SDL_CreateRGBSurfaceWithFormat(0, kWidth, kHeight, 32, SDL_PIXELFORMAT_RGBA8888);
+  if (nullptr == canvas_) {
+    std::cout << "Failed to create surface : " << SDL_GetError() << std::endl;
+    exit(-1);
+  }
+  renderer_ = SDL_CreateSoftwareRenderer(canvas_);
+  if (nullptr == renderer_) {
+    std::cout << "Failed to create software renderer : " << SDL_GetError() << std::endl;
+    exit(-1);
+  }
 }
 
 void Playfield::NewGame() {
-  x_ = y_ = 0;
-  ClearTexture(renderer_, surface_);
+  x_ = kPlayerStartX;
+  y_ = kPlayerStartY;
+  stix_.clear();
+  grid_.Reset();
+  border_.Reset();
+  distance_field_.Build(grid_);
+  claim_tracker_.Reset();
+  collision_.ClearTrail();
+  deaths_ = 0;
+  paused_ = false;
+  redraw_ = true;
+  ResetObjects();
+  seed_++;
+}
+
+void Playfield::ResetObjects() {
+  qix_objects_.Reset();
+  entities_.Clear();
+  qix_ = qix_objects_.Create(kPlayFieldWidth / 2, kPlayFieldHeight / 2, seed_);
+  // Two Sparx leave the top in opposite directions
+  sparx_.clear();
+  sparx_.push_back({ {}, BorderGraph::Turn::Right });
+  sparx_.push_back({ {}, BorderGraph::Turn::Left });
+  for (auto& sparx : sparx_) {
+    SpawnSparx(sparx);
+  }
+}
+
+void Playfield::SpawnSparx(Sparx& sparx) {
+  const int x = kPlayFieldWidth / 2;
+  int y = 0;
+
+  // The top of the border may have been claimed, the first border cell below it is used instead
+  while (y < kPlayFieldHeight - 1 && !border_.IsOnBorder(x, y)) {
+    y++;
+  }
+  sparx.walker = { x, y, (BorderGraph::Turn::Right == sparx.turn) ? BorderGraph::Direction::Right
+                                                                  : BorderGraph::Direction::Left };
+  sparx.travel = 0.0;
+  // Created where it enters, it is not drawn moving there from where it was
+  for (size_t i = 0; i < sparx.lines.size(); ++i) {
+    entities_.Destroy(sparx.lines[i]);
+    sparx.lines[i] = entities_.Create(static_cast<float>(x), static_cast<float>(y), 45 + static_cast<int>(i) * 90,
+                                      kSparxSize, 0.0f, Color::Yellow);
+  }
 }
 
 void Playfield::GameControl(Controls control_pressed) {
+  if (paused_ && Controls::ToggleHud != control_pressed) {
+    return;
+  }
   switch (control_pressed) {
     case Controls::Up:
-      if (y_ <= 0) {
-        break;
-      }
-      y_--;
-      DrawPixel(renderer_, surface_, x_, y_);
+      Move(0, -1);
       break;
     case Controls::Down:
-      if (y_ >= kHeight) {
-        break;
-      }
-      y_++;
-      DrawPixel(renderer_, surface_, x_, y_);
+      Move(0, 1);
       break;
     case Controls::Left:
-      /*if (x_ <= 0) {
-        break;
-      }
-      x_--;
-      DrawPixel(renderer_, surface_, x_, y_);*/
-      {
-        auto ptr = dynamic_cast<LineDraw *>(objects_.front().get());
-        direction_+=1;
-        if (direction_ > 360) {
-          direction_ = 0;
-        }
-        ptr->SetDirection(direction_);
-      }
+      Move(-1, 0);
       break;
     case Controls::Right:
-      /*if (x_ >= kWidth) {
-        break;
-      }
-      x_++;
-      DrawPixel(renderer_, surface_, x_, y_);*/
-      {
-        auto ptr = dynamic_cast<LineDraw *>(objects_.front().get());
-
-        direction_-=1;
-        if (direction_ < 0) {
-          direction_ = 360;
-        }
-        ptr->SetDirection(direction_);
-      }
+      Move(1, 0);
       break;
     case Controls::Fast:
       break;
     case Controls::Slow:
       break;
+    case Controls::ToggleHud:
+      if (hud_) {
+        hud_->Toggle();
+        redraw_ = true;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void Playfield::Move(int dx, int dy) {
+  const int x = x_ + dx;
+  const int y = y_ + dy;
+
+  if (!grid_.IsInside(x, y)) {
+    return;
+  }
+  switch (grid_.Get(x, y)) {
+    case Grid::Cell::Edge:
+      // Off the stix the player only moves along the border
+      if (stix_.empty() && border_.IsOnBorder(x_, y_) && !border_.Connects(x_, y_, dx, dy)) {
+        break;
+      }
+      x_ = x;
+      y_ = y;
+      if (!stix_.empty()) {
+        ClaimArea();
+      }
+      break;
+    case Grid::Cell::Unclaimed:
+      if (stix_.empty()) {
+        stix_start_ = { x_, y_ };
+      }
+      collision_.AddTrail({ static_cast<float>(x_), static_cast<float>(y_), static_cast<float>(x), static_cast<float>(y) });
+      x_ = x;
+      y_ = y;
+      grid_.Set(x_, y_, Grid::Cell::Stix);
+      stix_.push_back({ x_, y_ });
+      break;
     default:
+      // Claimed area and the stix itself can't be crossed
       break;
   }
 }
 
-void Playfield::Render(double delta) {
-  SDL_RenderClear(renderer_);
-  SDL_RenderCopy(renderer_, surface_, nullptr, nullptr);
-  SDL_SetRenderTarget(renderer_, nullptr);
-  RenderObjects(objects_, delta);
+void Playfield::ClaimArea() {
+  for (const auto& pt : stix_) {
+    grid_.Set(pt.x, pt.y, Grid::Cell::Edge);
+  }
+  // The fill starts from the Qix, from the leading line back. With no line on an unclaimed cell
+  // the Qix is on the stix and the stix is cut, an edge across unclaimed space would stay forever.
+  const auto& lines = qix().lines();
+  bool filled = false;
+
+  for (int i = lines.size() - 1; i >= 0 && !filled; --i) {
+    filled = flood_fill_.Fill(grid_, static_cast<int>(lines.x(i)), static_cast<int>(lines.y(i))) > 0;
+  }
+  if (!filled) {
+    CutStix();
+    return;
+  }
+  border_.AddPath(stix_start_, stix_, { x_, y_ });
+  stix_.clear();
+  collision_.ClearTrail();
+  if (flood_fill_.ClaimUnmarked(grid_) > 0) {
+    const auto [y1, y2] = flood_fill_.claimed_rows();
+
+    claim_tracker_.Add(flood_fill_);
+    border_.Update(grid_, y1, y2);
+    distance_field_.Build(grid_);
+  }
+}
+
+void Playfield::CheckCollisions() {
+  if (stix_.empty()) {
+    return;
+  }
+  const auto& lines = qix().lines();
+  const float x = static_cast<float>(x_);
+  const float y = static_cast<float>(y_);
+
+  collision_.ClearMovers();
+  for (int i = 0; i < lines.size(); ++i) {
+    const auto [x1, y1, x2, y2] = lines.line(i);
+
+    if (collision_.HitsTrail({ x1, y1, x2, y2 })) {
+      CutStix();
+      return;
+    }
+    collision_.AddMover({ x1, y1, x2, y2 });
+  }
+  if (collision_.HitsMover({ x, y, x, y })) {
+    CutStix();
+  }
+}
+
+void Playfield::CutStix() {
+  for (const auto& pt : stix_) {
+    grid_.Set(pt.x, pt.y, Grid::Cell::Unclaimed);
+  }
+  stix_.clear();
+  collision_.ClearTrail();
+  x_ = stix_start_.x;
+  y_ = stix_start_.y;
+  deaths_++;
+}
+
+void Playfield::Update(double delta) {
+  if (paused_) {
+    return;
+  }
+  qix_objects_.ForEach([this, delta](QixObject& qix) { qix.Update(delta, distance_field_); });
+  entities_.Update(delta);
+  MoveSparx(delta);
+  CheckCollisions();
+}
+
+void Playfield::MoveSparx(double delta) {
+  for (auto& sparx : sparx_) {
+    sparx.travel += kSparxSpeed * delta;
+
+    const int steps = static_cast<int>(sparx.travel);
+
+    sparx.travel -= steps;
+    // Claimed from under it, it enters again
+    if (!border_.Walk(sparx.walker, steps, sparx.turn)) {
+      SpawnSparx(sparx);
+    }
+    for (const auto& line : sparx.lines) {
+      entities_.SetPosition(line, static_cast<float>(sparx.walker.x), static_cast<float>(sparx.walker.y));
+    }
+  }
+  if (!stix_.empty()) {
+    return;
+  }
+  // Sparx move at most a cell per tick, one next to the player on the border is a hit
+  for (const auto& sparx : sparx_) {
+    if (std::abs(sparx.walker.x - x_) + std::abs(sparx.walker.y - y_) <= 1) {
+      deaths_++;
+      for (auto& other : sparx_) {
+        SpawnSparx(other);
+      }
+      return;
+    }
+  }
+}
+
+void Playfield::Record(double alpha, CommandBuffer& commands) {
+  if (nullptr == renderer_) {
+    return;
+  }
+  // Nothing moves while paused, unless something was toggled the frame on screen is still right.
+  // The commands are recorded anyway, in case the window has to be drawn again.
+  commands.SetUnchanged(skip_idle_frames_ && paused_ && !redraw_ && !grid_.IsDirty() && !hud_->IsVisible());
+  redraw_ = false;
+  RecordGrid(commands);
+  commands.AddCopy(surface_, kPlayFieldRect);
+  // Nothing moves while paused, everything is drawn where the last tick left it
+  const float object_alpha = paused_ ? 1.0f : static_cast<float>(alpha);
+
+  qix_objects_.ForEach([&commands, object_alpha](QixObject& qix) { qix.Render(commands, object_alpha); });
+  entities_.Render(commands, object_alpha);
+}
+
+void Playfield::RecordGrid(CommandBuffer& commands) {
+  if (!grid_.IsDirty()) {
+    return;
+  }
+  spans_.clear();
+  grid_.ForEachDirtySpan([this](const SDL_Rect& rc) { spans_.push_back(rc); });
+  rasterizer_->Render(grid_.row(0), grid_.words_per_row(), spans_);
+  for (const auto& rc : spans_) {
+    auto pixel = commands.AddUpload(surface_, rc);
+
+    for (int y = rc.y; y < rc.y + rc.h; ++y) {
+      pixel = std::copy_n(rasterizer_->row(y) + rc.x, rc.w, pixel);
+    }
+  }
+  grid_.ClearDirty();
+}
+
+bool Playfield::Submit(const CommandBuffer& commands) {
+  if (nullptr == renderer_ || (commands.IsUnchanged() && !invalidated_)) {
+    return false;
+  }
+  invalidated_ = false;
+  {
+    ScopedTimer timer(profiler_, Profiler::Phase::Render);
+
+    SDL_RenderClear(renderer_);
+    command_renderer_->Submit(commands);
+    hud_->Render(profiler_);
+  }
+  ScopedTimer timer(profiler_, Profiler::Phase::Present);
+
   SDL_RenderPresent(renderer_);
+
+  return true;
 }
 
-void Playfield::Update(double delta_time) { Render(delta_time); }
+void Playfield::Render(double alpha) {
+  commands_.Clear();
+  Record(alpha, commands_);
+  Submit(commands_);
+}
@@ -2,16 +2,34 @@
 
 #include <SDL.h>
 #include <SDL_ttf.h>
-#include <deque>
+#include <vector>
 
+#include "game/grid.h"
+#include "game/border_graph.h"
+#include "game/flood_fill.h"
+#include "game/distance_field.h"
+#include "game/claim_tracker.h"
+#include "game/collision.h"
 #include "game/objects.h"
+#include "game/entities.h"
 #include "utility/game_controller.h"
+#include "utility/perf_hud.h"
+#include "utility/glyph_atlas.h"
+#include "utility/profiler.h"
+#include "utility/object_pool.h"
+#include "utility/rasterizer.h"
+#include "utility/render_commands.h"
 
 class Playfield final {
  public:
-  enum class Controls { None, Left, Right, Up, Down, Start, Pause, Quit, Slow, Fast };
+  enum class Controls { None, Left, Right, Up, Down, Start, Pause, Quit, Slow, Fast, ToggleHud };
+  // Window renders to screen, Software renders to an off-screen surface and Null does not
+  // render at all. Only Window needs a display and a GPU.
+  enum class Backend { Window, Software, Null };
+  // Seeds the Qix until SetSeed is called
+  static constexpr uint64_t kDefaultSeed = 1981;
 
-  Playfield();
+  explicit Playfield(Backend backend = Backend::Window);
 
   Playfield(const Playfield&) = delete;
 
@@ -21,27 +39,140 @@ class Playfield final {
 
   void NewGame();
 
-  void Pause() {}
+  // The next game started is seeded with seed and every game after it with the seed following
+  // the one before, the same seed gives the same games
+  inline void SetSeed(uint64_t seed) { seed_ = seed; }
+
+  // Toggles pause, the logic stops while rendering keeps going
+  void Pause() {
+    paused_ = !paused_;
+    redraw_ = true;
+  }
+
+  inline bool IsPaused() const { return paused_; }
 
   void GameControl(Controls control_pressed);
 
-  void HandleGameControllerEvent(SDL_Event& event) { game_controller_->HandleEvents(event); }
+  void HandleGameControllerEvent(SDL_Event& event) {
+    if (game_controller_) {
+      game_controller_->HandleEvents(event);
+    }
+  }
+
+  // Runs one fixed logic tick of delta seconds
+  void Update(double delta);
+
+  // Records the draw commands for the playfield alpha, 0 to 1, of the way from the previous to
+  // the last logic tick. Runs on the logic thread, nothing is drawn.
+  void Record(double alpha, utility::CommandBuffer& commands);
+
+  // Draws recorded commands, the HUD on top, and presents. Runs on the thread owning the renderer.
+  // Returns false without drawing if the commands are unchanged since the frame on screen.
+  bool Submit(const utility::CommandBuffer& commands);
+
+  // While paused, frames are only presented when something changes. Off by default.
+  inline void SetSkipIdleFrames(bool skip) { skip_idle_frames_ = skip; }
+
+  // The window needs to be drawn again, e.g. after it was exposed. Called on the submitting thread.
+  inline void Invalidate() { invalidated_ = true; }
+
+  // Records and submits on the calling thread
+  void Render(double alpha);
+
+  double ClaimedPercentage() const { return claim_tracker_.Percentage(); }
+
+  // Times the player was hit since the game started
+  inline int deaths() const { return deaths_; }
+
+  inline SDL_Point player() const { return { x_, y_ }; }
+
+  // True while the player is out drawing a stix
+  inline bool IsDrawing() const { return !stix_.empty(); }
+
+  inline const Grid& grid() const { return grid_; }
 
-  void Update(double delta_timer);
+  inline const BorderGraph& border() const { return border_; }
+
+  inline Backend backend() const { return backend_; }
+
+  inline utility::Profiler& profiler() { return profiler_; }
 
  protected:
-  template<class T, class ...Args>
-  void AddObject(Args&&... args) { objects_.emplace_back(std::make_shared<T>(std::forward<Args>(args)...)); }
-  void Render(double delta_timer);
+  // A Sparx walks the border here, its position and appearance are two entities, lines
+  // crossing where it is
+  struct Sparx {
+    BorderGraph::Walker walker;
+    BorderGraph::Turn turn = BorderGraph::Turn::Right;
+    // Part of a cell moved but not yet stepped
+    double travel = 0.0;
+    std::array<Entities::Handle, 2> lines = {};
+  };
+
+  // Every object is destroyed and the ones a level starts with are created again
+  void ResetObjects();
+
+  inline QixObject& qix() const { return *qix_objects_.Get(qix_); }
+
+  void CreateWindowRenderer();
+
+  void CreateSoftwareRenderer();
+
+  // Rasterizes the changed tiles of the grid and records an upload for every run of them
+  void RecordGrid(utility::CommandBuffer& commands);
+
+  void Move(int dx, int dy);
+
+  void ClaimArea();
+
+  void CheckCollisions();
+
+  // Sparx run along the border, turning the same way at every junction, and hit the player if
+  // it is on the border next to one
+  void MoveSparx(double delta);
+
+  // A Sparx is back where Sparx enter, at the top of the border, its lines are created again
+  void SpawnSparx(Sparx& sparx);
+
+  // The Qix hit the stix or the player, the stix is erased and the player is back where it started
+  void CutStix();
 
  private:
+  Backend backend_;
   SDL_Window* window_ = nullptr;
+  SDL_Surface* canvas_ = nullptr;
   SDL_Renderer* renderer_ = nullptr;
   SDL_Texture* surface_ = nullptr;
+  std::unique_ptr<utility::JobSystem> jobs_;
+  std::unique_ptr<utility::Rasterizer> rasterizer_;
+  std::vector<SDL_Rect> spans_;
 
+  Grid grid_;
+  BorderGraph border_;
+  FloodFill flood_fill_;
+  DistanceField distance_field_;
+  ClaimTracker claim_tracker_;
+  Collision collision_;
   int x_ = 0;
   int y_ = 0;
-  int direction_ = 0;
-  std::deque<std::shared_ptr<Object>> objects_;
+  int deaths_ = 0;
+  // Seeds the next game
+  uint64_t seed_;
+  std::vector<SDL_Point> stix_;
+  SDL_Point stix_start_ = {};
+  utility::ObjectPool<QixObject> qix_objects_;
+  utility::PoolHandle qix_;
+  Entities entities_;
+  std::vector<Sparx> sparx_;
+  utility::CommandBuffer commands_;
+  std::unique_ptr<utility::CommandRenderer> command_renderer_;
+  bool paused_ = false;
+  // Set by the logic thread when a paused frame changes
+  bool redraw_ = true;
+  bool skip_idle_frames_ = false;
+  bool invalidated_ = false;
   std::shared_ptr<utility::GameController> game_controller_;
+  utility::Profiler profiler_;
+  std::shared_ptr<utility::Fonts> fonts_;
+  std::shared_ptr<utility::GlyphAtlas> atlas_;
+  std::unique_ptr<utility::PerfHud> hud_;
 };
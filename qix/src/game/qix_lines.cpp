@@ -0,0 +1,126 @@
+#include "game/qix_lines.h"
+
+#include <cmath>
+
+namespace {
+
+const float kPiDiv180 = static_cast<float>(M_PI / 180.0);
+
+}  // namespace
+
+QixLines::QixLines(int capacity)
+    : x_(capacity), y_(capacity), previous_x_(capacity), previous_y_(capacity), ux_(capacity), uy_(capacity), dx_(capacity), dy_(capacity), radius_(capacity),
+      velocity_(capacity), color_(capacity, utility::Color::None) {}
+
+void QixLines::Add(float x, float y, int direction, int length, float velocity, utility::Color color) {
+  if (size_ < capacity()) {
+    size_++;
+  } else {
+    first_ = (first_ + 1) % capacity();
+  }
+  const int i = size_ - 1;
+  const int n = slot(i);
+
+  x_[n] = previous_x_[n] = x;
+  y_[n] = previous_y_[n] = y;
+  velocity_[n] = velocity;
+  color_[n] = color;
+  SetLength(i, length);
+  SetDirection(i, direction);
+}
+
+void QixLines::SetDirection(int i, int angle) {
+  const int n = slot(i);
+  const float direction = kPiDiv180 * angle;
+  const float orientation = kPiDiv180 * (angle + 90);
+
+  // Screen y grows downwards
+  dx_[n] = std::cos(direction);
+  dy_[n] = -std::sin(direction);
+  ux_[n] = std::cos(orientation);
+  uy_[n] = -std::sin(orientation);
+}
+
+void QixLines::Advance() {
+  if (0 == size_) {
+    return;
+  }
+  const int newest = slot(size_ - 1);
+
+  if (size_ < capacity()) {
+    size_++;
+  } else {
+    first_ = (first_ + 1) % capacity();
+  }
+  Copy(slot(size_ - 1), newest);
+}
+
+void QixLines::Update(double delta) {
+  const int n = capacity();
+  const float d = static_cast<float>(delta);
+  float* x = x_.data();
+  float* y = y_.data();
+  float* previous_x = previous_x_.data();
+  float* previous_y = previous_y_.data();
+  const float* dx = dx_.data();
+  const float* dy = dy_.data();
+  const float* velocity = velocity_.data();
+
+  // Unused slots have zero velocity, so the whole buffer is updated without any branch
+  for (int i = 0; i < n; ++i) {
+    const float step = velocity[i] * d;
+
+    previous_x[i] = x[i];
+    previous_y[i] = y[i];
+    x[i] += dx[i] * step;
+    y[i] += dy[i] * step;
+  }
+}
+
+void QixLines::Render(utility::CommandBuffer& commands, float alpha) const {
+  for (int i = 0; i < size_; ++i) {
+    const int n = slot(i);
+    const float x = previous_x_[n] + (x_[n] - previous_x_[n]) * alpha;
+    const float y = previous_y_[n] + (y_[n] - previous_y_[n]) * alpha;
+    const float ex = ux_[n] * radius_[n];
+    const float ey = uy_[n] * radius_[n];
+
+    commands.Add(x + ex, y + ey, x - ex, y - ey, color_[n]);
+  }
+}
+
+std::array<float, 4> QixLines::line(int i) const {
+  const int n = slot(i);
+  const float ex = ux_[n] * radius_[n];
+  const float ey = uy_[n] * radius_[n];
+
+  return { x_[n] + ex, y_[n] + ey, x_[n] - ex, y_[n] - ey };
+}
+
+SDL_Point QixLines::center() const {
+  if (0 == size_) {
+    return {};
+  }
+  float x = 0.0f;
+  float y = 0.0f;
+
+  for (int i = 0; i < size_; ++i) {
+    x += x_[slot(i)];
+    y += y_[slot(i)];
+  }
+  return { static_cast<int>(x / size_), static_cast<int>(y / size_) };
+}
+
+void QixLines::Copy(int to, int from) {
+  x_[to] = x_[from];
+  y_[to] = y_[from];
+  previous_x_[to] = previous_x_[from];
+  previous_y_[to] = previous_y_[from];
+  ux_[to] = ux_[from];
+  uy_[to] = uy_[from];
+  dx_[to] = dx_[from];
+  dy_[to] = dy_[from];
+  radius_[to] = radius_[from];
+  velocity_[to] = velocity_[from];
+  color_[to] = color_[from];
+}
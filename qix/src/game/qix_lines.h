@@ -0,0 +1,75 @@
+#pragma once
+
+#include "utility/color.h"
+#include "utility/render_commands.h"
+
+#include <array>
+#include <vector>
+
+// The lines making up a Qix, stored as one array per attribute so that the per-frame update is
+// a single loop over contiguous floats. The orientation and heading of a line are only turned
+// into unit vectors when they change, never while moving or rendering. Lines live in a ring
+// buffer of fixed capacity, Advance() turns the oldest line into a copy of the newest one so a
+// trail moves along without allocating.
+class QixLines final {
+ public:
+  explicit QixLines(int capacity);
+
+  QixLines(const QixLines&) = delete;
+
+  // Adds a line as the newest one, overwriting the oldest line once the buffer is full
+  void Add(float x, float y, int direction, int length, float velocity, utility::Color color);
+
+  // Angle in degrees, counter clockwise with 0 pointing right. The line is drawn perpendicular to it.
+  void SetDirection(int i, int angle);
+
+  inline void SetVelocity(int i, float velocity) { velocity_[slot(i)] = velocity; }
+
+  inline void SetColor(int i, utility::Color color) { color_[slot(i)] = color; }
+
+  inline void SetLength(int i, int length) { radius_[slot(i)] = length / 2.0f; }
+
+  // Copies the newest line into a new slot, once the buffer is full the oldest line is reused
+  void Advance();
+
+  void Update(double delta);
+
+  // Records every line, alpha of the way from its position before the last update
+  void Render(utility::CommandBuffer& commands, float alpha = 1.0f) const;
+
+  SDL_Point center() const;
+
+  // Lines are indexed from oldest, 0, to newest, size() - 1
+  inline float x(int i) const { return x_[slot(i)]; }
+
+  inline float y(int i) const { return y_[slot(i)]; }
+
+  // End points x1, y1, x2, y2 of a line at its current position
+  std::array<float, 4> line(int i) const;
+
+  inline int size() const { return size_; }
+
+  inline int capacity() const { return static_cast<int>(x_.size()); }
+
+ protected:
+  inline int slot(int i) const { return (first_ + i) % capacity(); }
+
+  void Copy(int to, int from);
+
+ private:
+  int first_ = 0;
+  int size_ = 0;
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> previous_x_;
+  std::vector<float> previous_y_;
+  // Unit vector from the center to one end of the line
+  std::vector<float> ux_;
+  std::vector<float> uy_;
+  // Unit vector of the heading
+  std::vector<float> dx_;
+  std::vector<float> dy_;
+  std::vector<float> radius_;
+  std::vector<float> velocity_;
+  std::vector<utility::Color> color_;
+};
@@ -0,0 +1,132 @@
+#include "game/replay.h"
+#include "game/constants.h"
+#include "utility/varint.h"
+
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+
+namespace {
+
+using Controls = Playfield::Controls;
+
+const uint8_t kMagic[] = { 'Q', 'I', 'X', 'R' };
+const uint8_t kVersion = 2;
+const int kControlBits = 4;
+
+static_assert(static_cast<int>(Controls::ToggleHud) < (1 << kControlBits), "Controls must fit in the low bits");
+
+void PutHeader(std::vector<uint8_t>& buffer, uint64_t seed) {
+  buffer.insert(buffer.end(), std::begin(kMagic), std::end(kMagic));
+  buffer.push_back(kVersion);
+  utility::PutVarint(buffer, kLogicTicksPerSecond);
+  utility::PutVarint(buffer, seed);
+}
+
+void PutRecord(std::vector<uint8_t>& buffer, int64_t ticks_since_last, Controls control) {
+  const auto value = (static_cast<uint64_t>(ticks_since_last) << kControlBits) | static_cast<uint64_t>(control);
+
+  utility::PutVarint(buffer, value);
+}
+
+}  // namespace
+
+ReplayRecorder::ReplayRecorder(const std::string& filename, uint64_t seed) : file_(filename, std::ios::binary | std::ios::trunc) {
+  if (!file_) {
+    std::cout << "Failed to create replay : " << filename << std::endl;
+    exit(-1);
+  }
+  PutHeader(buffer_, seed);
+  writer_ = std::thread(&ReplayRecorder::Write, this);
+}
+
+ReplayRecorder::~ReplayRecorder() noexcept {
+  Flush();
+  // An empty chunk tells the writer that nothing more is coming
+  queue_.Push({});
+  writer_.join();
+}
+
+void ReplayRecorder::Add(int64_t tick, Playfield::Controls control) {
+  PutRecord(buffer_, tick - last_tick_, control);
+  last_tick_ = tick;
+  size_++;
+}
+
+void ReplayRecorder::Flush() {
+  if (buffer_.empty()) {
+    return;
+  }
+  queue_.Push(std::move(buffer_));
+  buffer_.clear();
+}
+
+void ReplayRecorder::Write() {
+  while (true) {
+    const auto chunk = queue_.Pop();
+
+    if (chunk.empty()) {
+      break;
+    }
+    file_.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    file_.flush();
+  }
+}
+
+ReplayPlayer::ReplayPlayer(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+
+  if (!file) {
+    std::cout << "Failed to open replay : " << filename << std::endl;
+    exit(-1);
+  }
+  const std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  if (!DecodeReplay(buffer, records_, seed_)) {
+    std::cout << "Invalid replay : " << filename << std::endl;
+    exit(-1);
+  }
+}
+
+std::vector<uint8_t> EncodeReplay(const std::vector<ReplayRecord>& records, uint64_t seed) {
+  std::vector<uint8_t> buffer;
+  int64_t last_tick = 0;
+
+  PutHeader(buffer, seed);
+  for (const auto& record : records) {
+    PutRecord(buffer, record.tick - last_tick, record.control);
+    last_tick = record.tick;
+  }
+  return buffer;
+}
+
+bool DecodeReplay(const std::vector<uint8_t>& buffer, std::vector<ReplayRecord>& records, uint64_t& seed) {
+  const size_t kMagicSize = std::size(kMagic);
+  size_t offset = kMagicSize + 1;
+  uint64_t value = 0;
+
+  if (buffer.size() < offset || !std::equal(std::begin(kMagic), std::end(kMagic), buffer.begin()) ||
+      kVersion != buffer[kMagicSize]) {
+    return false;
+  }
+  if (!utility::GetVarint(buffer, offset, value) || static_cast<uint64_t>(kLogicTicksPerSecond) != value) {
+    return false;
+  }
+  if (!utility::GetVarint(buffer, offset, seed)) {
+    return false;
+  }
+  int64_t tick = 0;
+
+  records.clear();
+  // A varint cut off at the end is a recording that was interrupted, keep what came before it
+  while (utility::GetVarint(buffer, offset, value)) {
+    const auto control = static_cast<Controls>(value & ((1 << kControlBits) - 1));
+
+    if (control > Controls::ToggleHud) {
+      return false;
+    }
+    tick += static_cast<int64_t>(value >> kControlBits);
+    records.push_back({ tick, control });
+  }
+  return true;
+}
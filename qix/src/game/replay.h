@@ -0,0 +1,95 @@
+#pragma once
+
+#include "game/playfield.h"
+#include "utility/threadsafe_queue.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <utility>
+
+// A replay is every control applied to the playfield, DAS repeats included, together with the
+// logic tick it was applied on. The playfield is deterministic, so applying the same controls
+// on the same ticks reproduces the session exactly.
+//
+// The file starts with the magic "QIXR", a version byte, the logic tick rate and the seed of
+// the first game as varints, games after it are seeded from there on (see Playfield::SetSeed).
+// After that every record is a single varint holding the ticks since the previous record
+// shifted up four bits, with the control in the low four bits. The stream is append only, a
+// recording cut short by a crash is still readable up to its last complete record.
+struct ReplayRecord {
+  int64_t tick;
+  Playfield::Controls control;
+
+  inline bool operator==(const ReplayRecord& rhs) const { return tick == rhs.tick && control == rhs.control; }
+};
+
+// Encodes on the game thread and leaves the file writes to a background thread, so recording
+// never waits for the disk
+class ReplayRecorder final {
+ public:
+  ReplayRecorder(const std::string& filename, uint64_t seed);
+
+  ReplayRecorder(const ReplayRecorder&) = delete;
+
+  ~ReplayRecorder() noexcept;
+
+  // Ticks must never decrease
+  void Add(int64_t tick, Playfield::Controls control);
+
+  // Hands everything added since the last flush to the writer thread
+  void Flush();
+
+  inline size_t size() const { return size_; }
+
+ protected:
+  void Write();
+
+ private:
+  std::ofstream file_;
+  std::vector<uint8_t> buffer_;
+  ThreadSafeQueue<std::vector<uint8_t>> queue_;
+  std::thread writer_;
+  int64_t last_tick_ = 0;
+  size_t size_ = 0;
+};
+
+// Reads a whole replay up front and plays it back one tick at a time
+class ReplayPlayer final {
+ public:
+  explicit ReplayPlayer(const std::string& filename);
+
+  ReplayPlayer(std::vector<ReplayRecord> records, uint64_t seed) : records_(std::move(records)), seed_(seed) {}
+
+  ReplayPlayer(const ReplayPlayer&) = delete;
+
+  // Calls apply for every control recorded for tick, ticks must be played in order
+  template<typename Function>
+  void Play(int64_t tick, Function apply) {
+    for (; next_ < records_.size() && records_[next_].tick <= tick; ++next_) {
+      apply(records_[next_].control);
+    }
+  }
+
+  inline bool IsDone() const { return next_ == records_.size(); }
+
+  // Ticks until the last recorded control has been applied
+  inline int64_t length() const { return records_.empty() ? 0 : records_.back().tick + 1; }
+
+  inline const std::vector<ReplayRecord>& records() const { return records_; }
+
+  // Set it on the playfield before the first tick is played
+  inline uint64_t seed() const { return seed_; }
+
+ private:
+  std::vector<ReplayRecord> records_;
+  uint64_t seed_ = 0;
+  size_t next_ = 0;
+};
+
+std::vector<uint8_t> EncodeReplay(const std::vector<ReplayRecord>& records, uint64_t seed);
+
+// Returns false if the header is missing or was written by another version or for another tick rate
+bool DecodeReplay(const std::vector<uint8_t>& buffer, std::vector<ReplayRecord>& records, uint64_t& seed);
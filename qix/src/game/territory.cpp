@@ -0,0 +1,192 @@
+#include "game/territory.h"
+
+#include <cstdlib>
+#include <utility>
+#include <algorithm>
+
+namespace {
+
+inline bool IsSame(SDL_Point lhs, SDL_Point rhs) { return lhs.x == rhs.x && lhs.y == rhs.y; }
+
+inline bool IsOnSegment(SDL_Point pt, SDL_Point a, SDL_Point b) {
+  return pt.x >= std::min(a.x, b.x) && pt.x <= std::max(a.x, b.x) && pt.y >= std::min(a.y, b.y) &&
+         pt.y <= std::max(a.y, b.y);
+}
+
+inline int Distance(SDL_Point a, SDL_Point b) { return std::abs(a.x - b.x) + std::abs(a.y - b.y); }
+
+inline bool IsStraight(SDL_Point a, SDL_Point b, SDL_Point c) {
+  return (a.x == b.x && b.x == c.x) || (a.y == b.y && b.y == c.y);
+}
+
+}  // namespace
+
+Territory::Territory(int width, int height)
+    : width_(width), height_(height), total_area_(static_cast<int64_t>(width - 1) * (height - 1)) {
+  Reset();
+}
+
+void Territory::Reset() {
+  unclaimed_ = { { 0, 0 }, { width_ - 1, 0 }, { width_ - 1, height_ - 1 }, { 0, height_ - 1 } };
+  claimed_.clear();
+  claimed_area_ = 0;
+  BuildTrees();
+}
+
+int64_t Territory::Claim(SDL_Point start, const std::vector<SDL_Point>& stix, SDL_Point end, SDL_Point qix) {
+  const int first = FindEdge(start);
+  const int last = FindEdge(end);
+
+  if (first < 0 || last < 0 || !IsUnclaimed(qix.x, qix.y)) {
+    return 0;
+  }
+  // Only the cells where the stix turns are vertices
+  corners_.clear();
+  corners_.push_back(start);
+  for (size_t i = 0; i < stix.size(); ++i) {
+    const auto& next = (i + 1 < stix.size()) ? stix[i + 1] : end;
+
+    if (!IsStraight(corners_.back(), stix[i], next)) {
+      corners_.push_back(stix[i]);
+    }
+  }
+  corners_.push_back(end);
+  for (size_t i = 0; i + 1 < corners_.size(); ++i) {
+    if (IsOnSegment(qix, corners_[i], corners_[i + 1])) {
+      return 0;
+    }
+  }
+
+  // Vertices of the unclaimed polygon from start round to end, the rest are from end to start
+  const int n = static_cast<int>(unclaimed_.size());
+  int forward = (last - first + n) % n;
+
+  if (first == last && Distance(unclaimed_[first], end) < Distance(unclaimed_[first], start)) {
+    forward = n;
+  }
+  Polygon a;
+  Polygon b;
+
+  a.push_back(start);
+  for (int i = 1; i <= forward; ++i) {
+    a.push_back(unclaimed_[(first + i) % n]);
+  }
+  a.insert(a.end(), corners_.rbegin(), corners_.rend() - 1);
+  b.push_back(end);
+  for (int i = 1; i <= n - forward; ++i) {
+    b.push_back(unclaimed_[(last + i) % n]);
+  }
+  b.insert(b.end(), corners_.begin(), corners_.end() - 1);
+  Simplify(a);
+  Simplify(b);
+  if (IsInside(b, qix)) {
+    std::swap(a, b);
+  } else if (!IsInside(a, qix)) {
+    return 0;
+  }
+  const auto area = Area(b);
+
+  unclaimed_ = std::move(a);
+  claimed_.push_back(std::move(b));
+  claimed_area_ += area;
+  BuildTrees();
+
+  return area;
+}
+
+bool Territory::IsUnclaimed(int x, int y) const {
+  bool inside = false;
+
+  // Half open in y, a ray through a vertex crosses one of its two vertical edges
+  vertical_.Stab(y, [x, y, &inside](const Tree::Interval& interval) {
+    inside = inside ^ (interval.value.at > x && y < interval.value.high);
+  });
+  return inside && !IsOnBorder(x, y);
+}
+
+bool Territory::IsOnBorder(int x, int y) const {
+  bool border = false;
+
+  vertical_.Stab(y, [x, &border](const Tree::Interval& interval) { border = border || interval.value.at == x; });
+  horizontal_.Stab(x, [y, &border](const Tree::Interval& interval) { border = border || interval.value.at == y; });
+
+  return border;
+}
+
+int64_t Territory::Area(const Polygon& polygon) {
+  int64_t area = 0;
+
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const auto& a = polygon[i];
+    const auto& b = polygon[(i + 1) % polygon.size()];
+
+    area += static_cast<int64_t>(a.x) * b.y - static_cast<int64_t>(b.x) * a.y;
+  }
+  return std::abs(area) / 2;
+}
+
+int Territory::FindEdge(SDL_Point pt) const {
+  for (size_t i = 0; i < unclaimed_.size(); ++i) {
+    const auto& a = unclaimed_[i];
+    const auto& b = unclaimed_[(i + 1) % unclaimed_.size()];
+
+    if (IsOnSegment(pt, a, b) && !IsSame(pt, b)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool Territory::IsInside(const Polygon& polygon, SDL_Point pt) {
+  bool inside = false;
+
+  for (size_t i = 0; i < polygon.size(); ++i) {
+    const auto& a = polygon[i];
+    const auto& b = polygon[(i + 1) % polygon.size()];
+
+    if (a.x == b.x && a.x > pt.x && pt.y >= std::min(a.y, b.y) && pt.y < std::max(a.y, b.y)) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+void Territory::Simplify(Polygon& polygon) {
+  bool changed = true;
+
+  while (changed && polygon.size() > 2) {
+    changed = false;
+    for (size_t i = 0; i < polygon.size() && polygon.size() > 2; ++i) {
+      const auto& previous = polygon[(i + polygon.size() - 1) % polygon.size()];
+      const auto& next = polygon[(i + 1) % polygon.size()];
+
+      if (IsSame(polygon[i], next) || IsStraight(previous, polygon[i], next)) {
+        polygon.erase(polygon.begin() + i);
+        changed = true;
+      }
+    }
+  }
+}
+
+void Territory::BuildTrees() {
+  std::vector<Tree::Interval> vertical;
+  std::vector<Tree::Interval> horizontal;
+
+  for (size_t i = 0; i < unclaimed_.size(); ++i) {
+    const auto& a = unclaimed_[i];
+    const auto& b = unclaimed_[(i + 1) % unclaimed_.size()];
+
+    // Closed edges, the trees hold half open intervals
+    if (a.x == b.x) {
+      const Edge edge = { a.x, std::min(a.y, b.y), std::max(a.y, b.y) };
+
+      vertical.push_back({ edge.low, edge.high + 1, edge });
+    } else {
+      const Edge edge = { a.y, std::min(a.x, b.x), std::max(a.x, b.x) };
+
+      horizontal.push_back({ edge.low, edge.high + 1, edge });
+    }
+  }
+  vertical_.Build(std::move(vertical));
+  horizontal_.Build(std::move(horizontal));
+}
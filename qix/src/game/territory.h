@@ -0,0 +1,88 @@
+#pragma once
+
+#include "utility/interval_tree.h"
+
+#include <SDL.h>
+
+#include <vector>
+#include <cstdint>
+
+// The claimed territory as rectilinear polygons instead of cells. Points are the lattice points
+// of the grid, the field is the rectangle through the border cells. The unclaimed area is
+// always one polygon, a claim cuts it in two along the stix and the side without the Qix is
+// claimed. Claims never overlap, so their union is kept as the claimed pieces and its area is
+// the sum of their shoelace areas. A claim costs O(vertices), memory and time do not depend on
+// the size of the field. Point queries go through interval trees of the unclaimed edges.
+class Territory final {
+ public:
+  using Polygon = std::vector<SDL_Point>;
+
+  Territory(int width, int height);
+
+  Territory(const Territory&) = delete;
+
+  void Reset();
+
+  // Claims the side of a stix running from start to end, both on the border of the unclaimed
+  // area, away from the Qix. The stix can be every cell or only the corners. Returns the claimed
+  // area, zero and nothing changes if the Qix is on the stix or not inside the unclaimed area.
+  int64_t Claim(SDL_Point start, const std::vector<SDL_Point>& stix, SDL_Point end, SDL_Point qix);
+
+  // Strictly inside the unclaimed area
+  bool IsUnclaimed(int x, int y) const;
+
+  // On the border between the unclaimed area and everything else
+  bool IsOnBorder(int x, int y) const;
+
+  // Inside the field and neither unclaimed nor on the border of the unclaimed area
+  bool IsClaimed(int x, int y) const {
+    return x >= 0 && y >= 0 && x < width_ && y < height_ && !IsUnclaimed(x, y) && !IsOnBorder(x, y);
+  }
+
+  inline int64_t claimed_area() const { return claimed_area_; }
+
+  inline int64_t total_area() const { return total_area_; }
+
+  inline double Percentage() const { return (100.0 * claimed_area_) / total_area_; }
+
+  inline const Polygon& unclaimed() const { return unclaimed_; }
+
+  inline const std::vector<Polygon>& claimed() const { return claimed_; }
+
+  // Shoelace formula, either orientation
+  static int64_t Area(const Polygon& polygon);
+
+ protected:
+  // An axis aligned edge, at along the other axis, from low to high inclusive
+  struct Edge {
+    int at;
+    int low;
+    int high;
+  };
+
+  using Tree = utility::IntervalTree<Edge>;
+
+  // The edge of the unclaimed polygon holding pt, the edge from vertex i to vertex i + 1 holds
+  // pt if pt is on it and not vertex i + 1. Returns -1 if no edge does.
+  int FindEdge(SDL_Point pt) const;
+
+  // Ray casting towards +x, pt must not be on the border of the polygon
+  static bool IsInside(const Polygon& polygon, SDL_Point pt);
+
+  // Drops repeated vertices and vertices in the middle of a straight line
+  static void Simplify(Polygon& polygon);
+
+  void BuildTrees();
+
+ private:
+  int width_;
+  int height_;
+  int64_t total_area_;
+  int64_t claimed_area_ = 0;
+  Polygon unclaimed_;
+  std::vector<Polygon> claimed_;
+  Polygon corners_;
+  // The vertical edges of the unclaimed polygon by y and the horizontal ones by x
+  Tree vertical_;
+  Tree horizontal_;
+};
@@ -1,21 +1,20 @@
 #include "utility/timer.h"
+#include "utility/alloc_counter.h"
+#include "utility/render_queue.h"
+#include "game/input.h"
+#include "game/replay.h"
 #include "game/playfield.h"
 
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
 #include <iostream>
-#include <set>
 
 namespace {
 
-// DAS settings
-const int64_t kAutoRepeatInitialDelay = 300; // milliseconds
-const int64_t kAutoRepeatSubsequentDelay = 50; // milliseconds
-
-const std::set<Playfield::Controls> kAutoRepeatControls = {
-  Playfield::Controls::Left,
-  Playfield::Controls::Right,
-  Playfield::Controls::Up,
-  Playfield::Controls::Down
-};
+const double kLogicTick = 1.0 / kLogicTicksPerSecond; // seconds
+const Uint32 kIdleFrameDelay = 16; // milliseconds, there is no vsync to wait for when nothing is presented
 
 }  // namespace
 
@@ -23,8 +22,6 @@ using namespace utility;
 
 class Qix {
  public:
-  using RepeatFunc = std::function<void()>;
-
   Qix() {
     if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
       std::cout << "SDL_Init Error: " << SDL_GetError() << std::endl;
@@ -37,9 +34,13 @@ class Qix {
     SDL_GameControllerEventState(SDL_ENABLE);
     SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS, "1");
     playfield_ = std::make_shared<Playfield>();
+    // Every session plays new games, a replay puts back the seed it was recorded with
+    seed_ = std::chrono::system_clock::now().time_since_epoch().count();
+    playfield_->SetSeed(seed_);
   }
 
   ~Qix() {
+    recorder_.reset();
     playfield_.reset();
     SDL_Quit();
     TTF_Quit();
@@ -73,6 +74,8 @@ class Qix {
       return Playfield::Controls::Pause;
     } else if (SDL_SCANCODE_Q == code) {
       return Playfield::Controls::Quit;
+    } else if (SDL_SCANCODE_F3 == code) {
+      return Playfield::Controls::ToggleHud;
     }
 
     return Playfield::Controls::None;
@@ -108,25 +111,76 @@ class Qix {
     return Playfield::Controls::None;
   }
 
-  template <Playfield::Controls control>
-  std::pair<Playfield::Controls, RepeatFunc> Repeatable(int& repeat_count, int64_t& time_since_last_auto_repeat) {
-    repeat_count = 0;
-    time_since_last_auto_repeat = kAutoRepeatInitialDelay;
-    return std::make_pair(control, [&playfield = playfield_]() { playfield->GameControl(control); });
+  // SDL stamps events with SDL_GetTicks() when they are pumped, move them onto the input clock
+  double ToInputTime(const SDL_Event& event) const {
+    const Uint32 age = SDL_GetTicks() - event.common.timestamp;
+
+    return input_.Now() - age / 1000.0;
+  }
+
+  void PushControl(Playfield::Controls control, bool pressed, const SDL_Event& event) {
+    if (Playfield::Controls::None == control) {
+      return;
+    }
+    if (!input_.Push(control, pressed, ToInputTime(event))) {
+      std::cout << "Input queue full, dropped control" << std::endl;
+    }
+  }
+
+  // Writes every control applied from now on to filename, call it after Replay
+  void Record(const std::string& filename) { recorder_ = std::make_unique<ReplayRecorder>(filename, seed_); }
+
+  // Plays the controls recorded in filename, live controls other than the HUD are ignored until it ends
+  void Replay(const std::string& filename) {
+    player_ = std::make_unique<ReplayPlayer>(filename);
+    seed_ = player_->seed();
+    playfield_->SetSeed(seed_);
+  }
+
+  void SkipIdleFrames() { playfield_->SetSkipIdleFrames(true); }
+
+  void HandleControl(Playfield::Controls control) {
+    if (player_ && !player_->IsDone() && Playfield::Controls::ToggleHud != control) {
+      return;
+    }
+    ApplyControl(control);
+  }
+
+  void ApplyControl(Playfield::Controls control) {
+    if (recorder_) {
+      recorder_->Add(tick_, control);
+    }
+    switch (control) {
+      case Playfield::Controls::Start:
+        playfield_->NewGame();
+        break;
+      case Playfield::Controls::Pause:
+        playfield_->Pause();
+        break;
+      default:
+        playfield_->GameControl(control);
+        break;
+    }
   }
 
+  // The logic, and recording what to draw, runs on a thread of its own while this thread owns
+  // the window: it polls events, submits recorded frames and waits for vsync. Controls reach
+  // the logic through the input queue, frames come back through the render queue.
   void Play() {
-    bool quit = false;
+    std::atomic<bool> quit = false;
+    std::thread logic([this, &quit] { RunLogic(quit); });
     DeltaTimer delta_timer;
-    int repeat_count = 0;
-    int64_t time_since_last_auto_repeat = 0;
-    int64_t auto_repeat_threshold = kAutoRepeatInitialDelay;
-    RepeatFunc function_to_repeat;
-    auto active_control = Playfield::Controls::None;
+    uint64_t allocations = AllocationCount();
     SDL_Event event;
 
     while (!quit) {
-      auto control = Playfield::Controls::None;
+      auto& profiler = playfield_->profiler();
+
+      profiler.Record(Profiler::Phase::Frame, delta_timer.GetDelta());
+      profiler.RecordAllocations(AllocationCount() - allocations);
+      allocations = AllocationCount();
+
+      DeltaTimer input_timer;
 
       while (SDL_PollEvent(&event)) {
         if (SDL_QUIT == event.type) {
@@ -135,21 +189,23 @@ class Qix {
         }
         switch (event.type) {
           case SDL_KEYDOWN:
-            control = TranslateKeyboardCommands(event);
-            break;
-          case SDL_CONTROLLERBUTTONDOWN:
-            control = TranslateControllerCommands(event);
-            break;
-          case SDL_KEYUP:
-            //std::cout << "UP ";
-            if (TranslateKeyboardCommands(event) == active_control) {
-              active_control = Playfield::Controls::None;
+          case SDL_KEYUP: {
+            const auto control = TranslateKeyboardCommands(event);
+
+            if (Playfield::Controls::Quit == control) {
+              quit = true;
+              break;
             }
+            PushControl(control, SDL_KEYDOWN == event.type, event);
             break;
+          }
+          case SDL_CONTROLLERBUTTONDOWN:
           case SDL_CONTROLLERBUTTONUP:
-            //std::cout << "UP ";
-            if (TranslateControllerCommands(event) == active_control) {
-              active_control = Playfield::Controls::None;
+            PushControl(TranslateControllerCommands(event), SDL_CONTROLLERBUTTONDOWN == event.type, event);
+            break;
+          case SDL_WINDOWEVENT:
+            if (SDL_WINDOWEVENT_EXPOSED == event.window.event || SDL_WINDOWEVENT_SIZE_CHANGED == event.window.event) {
+              playfield_->Invalidate();
             }
             break;
           case SDL_JOYDEVICEADDED:
@@ -160,58 +216,99 @@ class Qix {
             break;
         }
       }
-      switch (control) {
-        case Playfield::Controls::None:
-          break;
-        case Playfield::Controls::Left:
-          std::tie(active_control, function_to_repeat) =
-              Repeatable<Playfield::Controls::Left>(repeat_count, time_since_last_auto_repeat);
-          break;
-        case Playfield::Controls::Right:
-          std::tie(active_control, function_to_repeat) =
-              Repeatable<Playfield::Controls::Right>(repeat_count, time_since_last_auto_repeat);
-          break;
-        case Playfield::Controls::Up:
-          std::tie(active_control, function_to_repeat) =
-              Repeatable<Playfield::Controls::Up>(repeat_count, time_since_last_auto_repeat);
-          break;
-        case Playfield::Controls::Down:
-          std::tie(active_control, function_to_repeat) =
-              Repeatable<Playfield::Controls::Down>(repeat_count, time_since_last_auto_repeat);
-          break;
-        case Playfield::Controls::Start:
-          playfield_->NewGame();
-          active_control = control;
-          break;
-        case Playfield::Controls::Pause:
-          playfield_->Pause();
-          active_control = control;
-          break;
-        case Playfield::Controls::Quit:
-          quit = true;
-          break;
-        default:
-          playfield_->GameControl(control);
-          active_control = control;
-          break;
+      profiler.Record(Profiler::Phase::Input, input_timer.GetDelta());
+      if (quit) {
+        break;
+      }
+      const auto frame = render_queue_.BeginSubmit();
+
+      if (nullptr == frame) {
+        break;
+      }
+      const bool presented = playfield_->Submit(*frame);
+
+      render_queue_.EndSubmit();
+      if (!presented) {
+        SDL_Delay(kIdleFrameDelay);
+      }
+    }
+    quit = true;
+    render_queue_.Cancel();
+    logic.join();
+  }
+
+  // Logic runs at a fixed rate no matter the refresh rate, a slow frame is caught up with several
+  // ticks and the recorded frame interpolates between the last two of them. Each tick consumes
+  // the controls pressed, and the auto repeats due, up to its own time. Waiting for a free
+  // buffer paces the loop to the rate frames are submitted.
+  void RunLogic(const std::atomic<bool>& quit) {
+    DeltaTimer delta_timer;
+    FixedTimestep timestep(kLogicTick);
+    auto& profiler = playfield_->profiler();
+
+    while (!quit) {
+      const auto frame = render_queue_.BeginRecord();
+
+      if (nullptr == frame) {
+        break;
       }
-      if (kAutoRepeatControls.count(active_control) && (time_in_ms() - time_since_last_auto_repeat) >= auto_repeat_threshold) {
-        function_to_repeat();
-        auto_repeat_threshold = (0 == repeat_count) ? kAutoRepeatInitialDelay : kAutoRepeatSubsequentDelay;
-        repeat_count++;
-        time_since_last_auto_repeat = time_in_ms();
+      const double now = input_.Now();
+      const int ticks = timestep.Advance(delta_timer.GetDelta());
+      const double last_tick_time = now - timestep.alpha() * timestep.tick();
+      {
+        ScopedTimer update_timer(profiler, Profiler::Phase::Update);
+
+        for (int i = 0; i < ticks; ++i) {
+          input_.Process(last_tick_time - (ticks - 1 - i) * timestep.tick(),
+                         [this](Playfield::Controls control) { HandleControl(control); });
+          if (player_) {
+            player_->Play(tick_, [this](Playfield::Controls control) { ApplyControl(control); });
+          }
+          playfield_->Update(timestep.tick());
+          tick_++;
+        }
       }
-      playfield_->Update(delta_timer.GetDelta());
+      if (recorder_) {
+        recorder_->Flush();
+      }
+      playfield_->Record(timestep.alpha(), *frame);
+      render_queue_.EndRecord();
     }
   }
 
  private:
   std::shared_ptr<Playfield> playfield_ = nullptr;
+  Input input_;
+  int64_t tick_ = 0;
+  uint64_t seed_ = 0;
+  std::unique_ptr<ReplayRecorder> recorder_;
+  std::unique_ptr<ReplayPlayer> player_;
+  RenderQueue render_queue_;
 };
 
-int main(int, char *[]) {
+// qix [--record file] [--replay file] [--skip-idle]
+int main(int argc, char *argv[]) {
   Qix qix;
+  std::string record;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
 
+    if ("--record" == arg && i + 1 < argc) {
+      record = argv[++i];
+    } else if ("--replay" == arg && i + 1 < argc) {
+      qix.Replay(argv[++i]);
+    } else if ("--skip-idle" == arg) {
+      qix.SkipIdleFrames();
+    } else {
+      std::cout << "usage: qix [--record file] [--replay file] [--skip-idle]" << std::endl;
+      return -1;
+    }
+  }
+  // A recording of a replay is seeded the same
+  if (!record.empty()) {
+    qix.Record(record);
+  }
   qix.Play();
 
   return 0;
@@ -0,0 +1,122 @@
+#include "utility/alloc_counter.h"
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+
+std::atomic<uint64_t> allocation_count = 0;
+
+}  // namespace
+
+namespace utility {
+
+uint64_t AllocationCount() { return allocation_count.load(std::memory_order_relaxed); }
+
+} // namespace utility
+
+#if defined(QIX_COUNT_ALLOCATIONS)
+
+namespace {
+
+const std::size_t kDefaultAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+void* Allocate(std::size_t size, std::size_t alignment) noexcept {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  size = (size > 0) ? size : 1;
+  if (alignment <= kDefaultAlignment) {
+    return std::malloc(size);
+  }
+#if defined(_WIN32)
+  return _aligned_malloc(size, alignment);
+#else
+  // aligned_alloc wants a size that is a multiple of the alignment
+  return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+void* AllocateOrThrow(std::size_t size, std::size_t alignment) {
+  if (auto ptr = Allocate(size, alignment)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void Free(void* ptr, std::size_t alignment) noexcept {
+#if defined(_WIN32)
+  if (alignment > kDefaultAlignment) {
+    _aligned_free(ptr);
+    return;
+  }
+#endif
+  static_cast<void>(alignment);
+  std::free(ptr);
+}
+
+}  // namespace
+
+// Every form of new and delete is replaced, a form left out would pair the library allocator
+// with free or go uncounted
+
+void* operator new(std::size_t size) { return AllocateOrThrow(size, kDefaultAlignment); }
+
+void* operator new[](std::size_t size) { return AllocateOrThrow(size, kDefaultAlignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size, kDefaultAlignment); }
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size, kDefaultAlignment); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept { Free(ptr, kDefaultAlignment); }
+
+void operator delete[](void* ptr) noexcept { Free(ptr, kDefaultAlignment); }
+
+void operator delete(void* ptr, std::size_t) noexcept { Free(ptr, kDefaultAlignment); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { Free(ptr, kDefaultAlignment); }
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { Free(ptr, kDefaultAlignment); }
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { Free(ptr, kDefaultAlignment); }
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+  Free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+  Free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+  Free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+  Free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  Free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  Free(ptr, static_cast<std::size_t>(alignment));
+}
+
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+namespace utility {
+
+// Builds with QIX_COUNT_ALLOCATIONS defined (the CMake option of the same name, qix_test and
+// qix_sim only) replace the global operator new and delete to count every heap allocation. Other
+// builds leave the allocator alone and the count stays at zero.
+#if defined(QIX_COUNT_ALLOCATIONS)
+constexpr bool kCountAllocations = true;
+#else
+constexpr bool kCountAllocations = false;
+#endif
+
+// Heap allocations made by all threads since the program started
+uint64_t AllocationCount();
+
+} // namespace utility
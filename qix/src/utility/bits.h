@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace utility {
+
+// Bit scan helpers, v must not be zero
+inline int CountTrailingZeros(uint64_t v) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, v);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctzll(v);
+#endif
+}
+
+inline int CountLeadingZeros(uint64_t v) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse64(&index, v);
+  return 63 - static_cast<int>(index);
+#else
+  return __builtin_clzll(v);
+#endif
+}
+
+inline int PopCount(uint64_t v) {
+#if defined(_MSC_VER)
+  return static_cast<int>(__popcnt64(v));
+#else
+  return __builtin_popcountll(v);
+#endif
+}
+
+// Moves every even bit of v into the lower 32 bits, i.e. bit 2n ends up as bit n
+inline uint64_t CompactEvenBits(uint64_t v) {
+#if defined(__BMI2__)
+  return _pext_u64(v, 0x5555555555555555ull);
+#else
+  v &= 0x5555555555555555ull;
+  v = (v | (v >> 1)) & 0x3333333333333333ull;
+  v = (v | (v >> 2)) & 0x0f0f0f0f0f0f0f0full;
+  v = (v | (v >> 4)) & 0x00ff00ff00ff00ffull;
+  v = (v | (v >> 8)) & 0x0000ffff0000ffffull;
+  v = (v | (v >> 16)) & 0x00000000ffffffffull;
+  return v;
+#endif
+}
+
+// Inverse of CompactEvenBits, bit n of the lower 32 bits ends up as bit 2n
+inline uint64_t SpreadToEvenBits(uint64_t v) {
+#if defined(__BMI2__)
+  return _pdep_u64(v, 0x5555555555555555ull);
+#else
+  v &= 0x00000000ffffffffull;
+  v = (v | (v << 16)) & 0x0000ffff0000ffffull;
+  v = (v | (v << 8)) & 0x00ff00ff00ff00ffull;
+  v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0full;
+  v = (v | (v << 2)) & 0x3333333333333333ull;
+  v = (v | (v << 1)) & 0x5555555555555555ull;
+  return v;
+#endif
+}
+
+} // namespace utility
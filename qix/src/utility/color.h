@@ -32,6 +32,11 @@ inline const SDL_Color GetColor(Color color, uint8_t alpha = 255) {
   return { kColors[color].r, kColors[color].g, kColors[color].b, alpha };
 }
 
+inline uint32_t ToRGBA8888(Color color, uint8_t alpha = 255) {
+  return (static_cast<uint32_t>(kColors[color].r) << 24) | (static_cast<uint32_t>(kColors[color].g) << 16) |
+         (static_cast<uint32_t>(kColors[color].b) << 8) | alpha;
+}
+
 inline void SetColor(SDL_Renderer* renderer, uint8_t r, uint8_t g, uint8_t b, uint8_t alpha) { SDL_SetRenderDrawColor(renderer, r, g, b, alpha); }
 
 inline const std::tuple<uint8_t, uint8_t, uint8_t, uint8_t> UnpackColor(Color color, uint8_t alpha = 255) {
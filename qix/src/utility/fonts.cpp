@@ -37,9 +37,19 @@ TTF_Font *LoadFont(const std::string& name, int size) {
 namespace utility {
 
 TTF_Font* Fonts::Get(const Font& font) const {
-  if (font_cache_.count(font)) {
-    return font_cache_.at(font).get();
+  if (auto it = font_cache_.find(font.key()); it != font_cache_.end()) {
+    return it->second.get();
   }
+  return Load(font);
+}
+
+void Fonts::Preload(const std::vector<Font>& fonts) const {
+  for (const auto& font : fonts) {
+    Get(font);
+  }
+}
+
+TTF_Font* Fonts::Load(const Font& font) const {
   std::string file_name;
 
   try {
@@ -50,7 +60,7 @@ TTF_Font* Fonts::Get(const Font& font) const {
   }
   auto font_ptr = std::shared_ptr<TTF_Font>(LoadFont(file_name, font.size_), TTF_CloseFont);
 
-  font_cache_.insert(std::make_pair(font, font_ptr));
+  font_cache_.insert(std::make_pair(font.key(), font_ptr));
 
   return font_ptr.get();
 }
@@ -2,7 +2,9 @@
 
 #include <SDL_ttf.h>
 #include <unordered_map>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <memory>
 
 namespace utility {
@@ -13,13 +15,19 @@ struct Font {
 
   Font(Typeface typeface, Emphasis emphasis, int size) : typeface_(typeface), emphasis_(emphasis), size_(size) {}
 
+  // Unique for every font, typeface and emphasis in the top bits and size in the low 16 bits
+  inline uint32_t key() const {
+    return (static_cast<uint32_t>(typeface_) << 24) | (static_cast<uint32_t>(emphasis_) << 16) |
+           static_cast<uint16_t>(size_);
+  }
+
   Typeface typeface_;
   Emphasis emphasis_;
   int size_;
 };
 
 inline bool operator==(const Font& lhs, const Font& rhs) {
-  return lhs.typeface_ == rhs.typeface_ && lhs.emphasis_ == rhs.emphasis_ && lhs.size_ == rhs.size_;
+  return lhs.key() == rhs.key();
 }
 
 inline std::string ToString(Font::Typeface typeface) {
@@ -47,11 +55,7 @@ inline std::string ToString(Font::Emphasis emphasis) {
 namespace std {
 
 template<> struct hash<utility::Font> {
-  size_t operator()(const utility::Font& f) const noexcept {
-    std::string key = std::to_string(static_cast<int>(f.typeface_)) + std::to_string(static_cast<int>(f.emphasis_)) + std::to_string(f.size_);
-
-    return std::hash<std::string>{}(std::move(key));
-  }
+  size_t operator()(const utility::Font& f) const noexcept { return std::hash<uint32_t>{}(f.key()); }
 };
 
 } // namespace std;
@@ -70,8 +74,14 @@ class Fonts final {
 
   TTF_Font* Get(Font::Typeface typeface, Font::Emphasis emphasis, int size) const { return Get(Font(typeface, emphasis, size)); }
 
+  // Loads the fonts up front, Get() never has to read from disk for them later
+  void Preload(const std::vector<Font>& fonts) const;
+
+ protected:
+  TTF_Font* Load(const Font& font) const;
+
  private:
-  mutable std::unordered_map<Font, std::shared_ptr<TTF_Font>> font_cache_;
+  mutable std::unordered_map<uint32_t, std::shared_ptr<TTF_Font>> font_cache_;
 };
 
 } // namespace utility
@@ -0,0 +1,178 @@
+#include "utility/glyph_atlas.h"
+
+#include <iostream>
+#include <algorithm>
+
+namespace {
+
+const int kAtlasWidth = 512;
+const int kPadding = 1;
+const SDL_Color kWhite = { 255, 255, 255, 255 };
+
+struct RasterizedGlyph {
+  SDL_Surface* surface_ = nullptr;
+  int advance_ = 0;
+};
+
+}  // namespace
+
+namespace utility {
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer, const std::shared_ptr<Fonts>& fonts)
+    : renderer_(renderer), fonts_(fonts) {}
+
+int GlyphAtlas::Add(const Font& font, int x, int y, std::string_view text, Color color) {
+  auto& page = GetPage(font);
+
+  if (page.texture_ == nullptr) {
+    return 0;
+  }
+  const auto tint = GetColor(color);
+  int pen_x = x;
+
+  for (auto c : text) {
+    const auto& glyph = GetGlyph(page, c);
+
+    if (glyph.rc_.w > 0) {
+      page.quads_.push_back({ glyph.rc_, { pen_x, y, glyph.rc_.w, glyph.rc_.h }, tint });
+    }
+    pen_x += glyph.advance_;
+  }
+  return pen_x - x;
+}
+
+std::pair<int, int> GlyphAtlas::Measure(const Font& font, std::string_view text) {
+  const auto& page = GetPage(font);
+  int width = 0;
+
+  for (auto c : text) {
+    width += GetGlyph(page, c).advance_;
+  }
+  return std::make_pair(width, page.line_height_);
+}
+
+void GlyphAtlas::Render() {
+  for (auto& [font, page] : pages_) {
+    if (page->quads_.empty()) {
+      continue;
+    }
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    const float u = 1.0f / page->width_;
+    const float v = 1.0f / page->height_;
+
+    vertices_.clear();
+    for (const auto& q : page->quads_) {
+      const float x1 = static_cast<float>(q.target_.x);
+      const float y1 = static_cast<float>(q.target_.y);
+      const float x2 = static_cast<float>(q.target_.x + q.target_.w);
+      const float y2 = static_cast<float>(q.target_.y + q.target_.h);
+      const float u1 = q.source_.x * u;
+      const float v1 = q.source_.y * v;
+      const float u2 = (q.source_.x + q.source_.w) * u;
+      const float v2 = (q.source_.y + q.source_.h) * v;
+
+      vertices_.push_back({ { x1, y1 }, q.color_, { u1, v1 } });
+      vertices_.push_back({ { x2, y1 }, q.color_, { u2, v1 } });
+      vertices_.push_back({ { x1, y2 }, q.color_, { u1, v2 } });
+      vertices_.push_back({ { x2, y2 }, q.color_, { u2, v2 } });
+    }
+    for (int i = static_cast<int>(indices_.size() / 6) * 4; i < static_cast<int>(vertices_.size()); i += 4) {
+      indices_.insert(indices_.end(), { i, i + 1, i + 2, i + 1, i + 3, i + 2 });
+    }
+    SDL_RenderGeometry(renderer_, page->texture_.get(), vertices_.data(), static_cast<int>(vertices_.size()),
+                       indices_.data(), static_cast<int>(page->quads_.size() * 6));
+#else
+    for (const auto& q : page->quads_) {
+      SDL_SetTextureColorMod(page->texture_.get(), q.color_.r, q.color_.g, q.color_.b);
+      SDL_RenderCopy(renderer_, page->texture_.get(), &q.source_, &q.target_);
+    }
+#endif
+    page->quads_.clear();
+  }
+}
+
+void GlyphAtlas::Preload(const std::vector<Font>& fonts) {
+  fonts_->Preload(fonts);
+  for (const auto& font : fonts) {
+    GetPage(font);
+  }
+}
+
+GlyphAtlas::Page& GlyphAtlas::GetPage(const Font& font) {
+  if (auto it = pages_.find(font); it != pages_.end()) {
+    return *it->second;
+  }
+  auto page = std::make_unique<Page>();
+  auto ttf_font = fonts_->Get(font);
+
+  if (nullptr == ttf_font) {
+    return *pages_.emplace(font, std::move(page)).first->second;
+  }
+  page->line_height_ = TTF_FontLineSkip(ttf_font);
+
+  // Rasterize every glyph first to know how tall the atlas has to be
+  std::vector<RasterizedGlyph> rasterized;
+  int x = 0;
+  int y = 0;
+  int row_height = 0;
+
+  for (char c = kFirstGlyph; c <= kLastGlyph; ++c) {
+    RasterizedGlyph glyph;
+    int min_x, max_x, min_y, max_y;
+
+    if (0 == TTF_GlyphMetrics(ttf_font, c, &min_x, &max_x, &min_y, &max_y, &glyph.advance_)) {
+      glyph.surface_ = TTF_RenderGlyph_Blended(ttf_font, c, kWhite);
+    }
+    auto& rc = page->glyphs_[c - kFirstGlyph].rc_;
+
+    page->glyphs_[c - kFirstGlyph].advance_ = glyph.advance_;
+    if (nullptr != glyph.surface_) {
+      if (x + glyph.surface_->w > kAtlasWidth) {
+        x = 0;
+        y += row_height + kPadding;
+        row_height = 0;
+      }
+      rc = { x, y, glyph.surface_->w, glyph.surface_->h };
+      x += glyph.surface_->w + kPadding;
+      row_height = std::max(row_height, glyph.surface_->h);
+    }
+    rasterized.push_back(glyph);
+  }
+  page->width_ = kAtlasWidth;
+  page->height_ = y + row_height;
+
+  auto atlas = SDL_CreateRGBSurfaceWithFormat(0, page->width_, page->height_, 32, SDL_PIXELFORMAT_ARGB8888);
+
+  if (nullptr == atlas) {
+    std::cout << "Failed to create glyph atlas : " << SDL_GetError() << std::endl;
+    exit(-1);
+  }
+  SDL_FillRect(atlas, nullptr, 0);
+  for (size_t i = 0; i < rasterized.size(); ++i) {
+    auto surface = rasterized[i].surface_;
+
+    if (nullptr == surface) {
+      continue;
+    }
+    SDL_Rect rc = page->glyphs_[i].rc_;
+
+    // Copy the coverage as is instead of blending it onto the empty atlas
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(surface, nullptr, atlas, &rc);
+    SDL_FreeSurface(surface);
+  }
+  page->texture_ = UniqueTexturePtr{ SDL_CreateTextureFromSurface(renderer_, atlas) };
+  SDL_FreeSurface(atlas);
+  SDL_SetTextureBlendMode(page->texture_.get(), SDL_BLENDMODE_BLEND);
+
+  return *pages_.emplace(font, std::move(page)).first->second;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::GetGlyph(const Page& page, char c) {
+  if (c < kFirstGlyph || c > kLastGlyph) {
+    c = '?';
+  }
+  return page.glyphs_[c - kFirstGlyph];
+}
+
+} // namespace utility
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "utility/text.h"
+#include "utility/fonts.h"
+
+#include <array>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+
+namespace utility {
+
+// Draws text from one texture per font holding every printable ASCII glyph. Glyphs are
+// rasterized once, the first time a font is used, in white and tinted per quad when drawn.
+// Text is queued with Add() and everything queued for a font is drawn by Render() with one
+// SDL_RenderGeometry call (SDL 2.0.18 or later). Queues keep their capacity between frames.
+class GlyphAtlas final {
+ public:
+  GlyphAtlas(SDL_Renderer* renderer, const std::shared_ptr<Fonts>& fonts);
+
+  GlyphAtlas(const GlyphAtlas&) = delete;
+
+  // Queues text with its top left corner at x, y, returns the width of the text
+  int Add(const Font& font, int x, int y, std::string_view text, Color color);
+
+  // Width and height of the text, without drawing anything
+  std::pair<int, int> Measure(const Font& font, std::string_view text);
+
+  void Render();
+
+  // Loads and rasterizes the fonts up front instead of on first use in the middle of a frame
+  void Preload(const std::vector<Font>& fonts);
+
+ protected:
+  static constexpr char kFirstGlyph = ' ';
+  static constexpr char kLastGlyph = '~';
+
+  struct Glyph {
+    SDL_Rect rc_ = {};
+    int advance_ = 0;
+  };
+
+  struct Quad {
+    SDL_Rect source_;
+    SDL_Rect target_;
+    SDL_Color color_;
+  };
+
+  struct Page {
+    UniqueTexturePtr texture_;
+    int width_ = 0;
+    int height_ = 0;
+    int line_height_ = 0;
+    std::array<Glyph, kLastGlyph - kFirstGlyph + 1> glyphs_;
+    std::vector<Quad> quads_;
+  };
+
+  Page& GetPage(const Font& font);
+
+  static const Glyph& GetGlyph(const Page& page, char c);
+
+ private:
+  SDL_Renderer* renderer_;
+  std::shared_ptr<Fonts> fonts_;
+  std::unordered_map<Font, std::unique_ptr<Page>> pages_;
+  std::vector<SDL_Vertex> vertices_;
+  std::vector<int> indices_;
+};
+
+} // namespace utility
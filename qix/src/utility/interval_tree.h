@@ -0,0 +1,113 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace utility {
+
+// Static centered interval tree over half-open intervals [low, high). Every node keeps the
+// intervals holding its center twice, sorted by low and by high, so a stabbing query only
+// walks one path down the tree and stops scanning a node at the first interval that misses.
+// A query costs O(log n + k) for k intervals found. The tree is rebuilt, not updated.
+template<typename T>
+class IntervalTree final {
+ public:
+  struct Interval {
+    int64_t low;
+    int64_t high;
+    T value;
+  };
+
+  IntervalTree() = default;
+
+  IntervalTree(const IntervalTree&) = delete;
+
+  // Empty intervals hold no point and are left out
+  void Build(std::vector<Interval> intervals) {
+    intervals.erase(std::remove_if(intervals.begin(), intervals.end(), [](const Interval& i) {
+      return i.low >= i.high;
+    }), intervals.end());
+    nodes_.clear();
+    by_low_.clear();
+    by_high_.clear();
+    root_ = Build(intervals, 0, intervals.size());
+  }
+
+  // Calls function with every interval holding point
+  template<typename Function>
+  void Stab(int64_t point, Function function) const {
+    for (auto i = root_; kNone != i;) {
+      const auto& node = nodes_[i];
+
+      if (point < node.center) {
+        for (auto j = node.begin; j < node.end && by_low_[j].low <= point; ++j) {
+          function(by_low_[j]);
+        }
+        i = node.left;
+      } else {
+        for (auto j = node.begin; j < node.end && by_high_[j].high > point; ++j) {
+          function(by_high_[j]);
+        }
+        i = node.right;
+      }
+    }
+  }
+
+  inline size_t size() const { return by_low_.size(); }
+
+ protected:
+  static constexpr int32_t kNone = -1;
+
+  struct Node {
+    int64_t center;
+    // The intervals of the node in by_low_ and by_high_
+    size_t begin;
+    size_t end;
+    int32_t left;
+    int32_t right;
+  };
+
+  // Builds the subtree of intervals[first, last), which is reordered
+  int32_t Build(std::vector<Interval>& intervals, size_t first, size_t last) {
+    if (first == last) {
+      return kNone;
+    }
+    const auto begin = intervals.begin();
+    const auto middle = begin + (first + last) / 2;
+
+    std::nth_element(begin + first, middle, begin + last,
+                     [](const Interval& lhs, const Interval& rhs) { return lhs.low < rhs.low; });
+
+    const int64_t center = middle->low;
+    // Below the center, holding it, above it
+    const auto below = std::partition(begin + first, begin + last, [center](const Interval& i) {
+      return i.high <= center;
+    });
+    const auto above = std::partition(below, begin + last, [center](const Interval& i) { return i.low <= center; });
+    const auto id = static_cast<int32_t>(nodes_.size());
+
+    nodes_.push_back({ center, by_low_.size(), by_low_.size() + (above - below), kNone, kNone });
+    by_low_.insert(by_low_.end(), below, above);
+    by_high_.insert(by_high_.end(), below, above);
+    std::sort(by_low_.begin() + nodes_[id].begin, by_low_.end(),
+              [](const Interval& lhs, const Interval& rhs) { return lhs.low < rhs.low; });
+    std::sort(by_high_.begin() + nodes_[id].begin, by_high_.end(),
+              [](const Interval& lhs, const Interval& rhs) { return lhs.high > rhs.high; });
+
+    const auto split = static_cast<size_t>(above - begin);
+
+    nodes_[id].left = Build(intervals, first, static_cast<size_t>(below - begin));
+    nodes_[id].right = Build(intervals, split, last);
+
+    return id;
+  }
+
+ private:
+  std::vector<Node> nodes_;
+  std::vector<Interval> by_low_;
+  std::vector<Interval> by_high_;
+  int32_t root_ = kNone;
+};
+
+} // namespace utility
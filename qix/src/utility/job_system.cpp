@@ -0,0 +1,182 @@
+#include "utility/job_system.h"
+
+#include <string>
+#include <chrono>
+#include <fstream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+const int kSpinsBeforeSleep = 64;
+const auto kSleep = std::chrono::milliseconds(1);
+
+thread_local const utility::JobSystem* tls_system = nullptr;
+thread_local size_t tls_index = 0;
+
+void Pin([[maybe_unused]] std::thread& thread, [[maybe_unused]] int cpu) {
+#if defined(__linux__)
+  cpu_set_t set;
+
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#endif
+}
+
+}  // namespace
+
+namespace utility {
+
+JobSystem::JobSystem(size_t workers, bool pin) {
+  const auto cores = PhysicalCores();
+
+  if (0 == workers) {
+    workers = cores.size();
+  }
+  workers_.reserve(workers);
+  for (size_t i = 0; i < workers; ++i) {
+    workers_.emplace_back(std::make_unique<Worker>());
+  }
+  // Worker 0 is whichever thread outside the job system waits for it
+  for (size_t i = 1; i < workers; ++i) {
+    workers_[i]->thread = std::thread([this, i] { WorkerLoop(i); });
+    if (pin) {
+      Pin(workers_[i]->thread, cores[i % cores.size()]);
+    }
+  }
+}
+
+JobSystem::~JobSystem() noexcept {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  quit_ = true;
+  lock.unlock();
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
+
+void JobSystem::Wait(TaskGroup& group) {
+  const auto self = index();
+
+  while (!group.IsDone()) {
+    if (auto job = FindJob(self)) {
+      Execute(job);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+std::vector<int> JobSystem::PhysicalCores() {
+  const int cpus = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  std::vector<int> cores;
+
+  for (int cpu = 0; cpu < cpus; ++cpu) {
+    // Hyper threads of a core list the same siblings, the first of them represents the core
+    std::ifstream siblings("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list");
+    int first = cpu;
+
+    if (siblings >> first && first != cpu) {
+      continue;
+    }
+    cores.push_back(cpu);
+  }
+  return cores;
+}
+
+void JobSystem::Submit(std::atomic<size_t>* pending, void (*function)(Job&), void* context, size_t begin, size_t end,
+                       size_t grain) {
+  auto& worker = *workers_[index()];
+  auto& slot = worker.jobs[worker.next_job++ & (kMaxJobs - 1)];
+  // A thief may still be running the job last put in the slot
+  const bool is_free = !slot.in_flight.load(std::memory_order_acquire);
+  Job local;
+  auto& job = is_free ? slot : local;
+
+  job.function = function;
+  job.context = context;
+  job.begin = begin;
+  job.end = end;
+  job.grain = grain;
+  job.system = this;
+  job.pending = pending;
+  job.in_flight.store(true, std::memory_order_relaxed);
+  pending->fetch_add(1, std::memory_order_relaxed);
+  if (!is_free || !worker.deque.Push(&job)) {
+    Execute(&job);
+    return;
+  }
+  if (sleeping_.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    wake_.notify_one();
+  }
+}
+
+size_t JobSystem::index() const { return (this == tls_system) ? tls_index : 0; }
+
+Job* JobSystem::FindJob(size_t index) {
+  if (auto job = workers_[index]->deque.Pop()) {
+    return job;
+  }
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    if (auto job = workers_[(index + i) % workers_.size()]->deque.Steal()) {
+      return job;
+    }
+  }
+  return nullptr;
+}
+
+bool JobSystem::HasJobs() const {
+  for (const auto& worker : workers_) {
+    if (!worker->deque.IsEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void JobSystem::Execute(Job* job) {
+  const auto pending = job->pending;
+
+  job->function(*job);
+  // The slot may be reused from here on, the job is not read again
+  job->in_flight.store(false, std::memory_order_release);
+  pending->fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::WorkerLoop(size_t index) {
+  tls_system = this;
+  tls_index = index;
+
+  int idle = 0;
+
+  while (!quit_.load(std::memory_order_relaxed)) {
+    if (auto job = FindJob(index)) {
+      Execute(job);
+      idle = 0;
+      continue;
+    }
+    if (++idle < kSpinsBeforeSleep) {
+      std::this_thread::yield();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    sleeping_++;
+    // The timeout covers a job pushed between the last look and going to sleep
+    wake_.wait_for(lock, kSleep, [this] { return quit_.load() || HasJobs(); });
+    sleeping_--;
+    idle = 0;
+  }
+}
+
+} // namespace utility
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <condition_variable>
+
+namespace utility {
+
+class JobSystem;
+
+// A function to run, and the task group waiting for it. The slot holding it is not reused while
+// in_flight is set.
+struct Job {
+  void (*function)(Job& job) = nullptr;
+  void* context = nullptr;
+  size_t begin = 0;
+  size_t end = 0;
+  size_t grain = 0;
+  JobSystem* system = nullptr;
+  std::atomic<size_t>* pending = nullptr;
+  std::atomic<bool> in_flight = false;
+};
+
+// Chase-Lev deque of jobs with a fixed capacity. The worker owning it pushes and pops at the
+// bottom, any other worker steals from the top, none of them take a lock.
+class WorkStealingDeque final {
+ public:
+  static constexpr int64_t kCapacity = 4096;
+
+  WorkStealingDeque() = default;
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+
+  // Owner only, returns false if the deque is full
+  bool Push(Job* job) {
+    const auto bottom = bottom_.load(std::memory_order_relaxed);
+    const auto top = top_.load(std::memory_order_acquire);
+
+    if (bottom - top >= kCapacity) {
+      return false;
+    }
+    jobs_[bottom & kMask].store(job, std::memory_order_relaxed);
+    // Publishes the job, and what it points to, to thieves loading the bottom
+    bottom_.store(bottom + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  // Owner only, the job pushed last
+  Job* Pop() {
+    const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    auto top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto job = jobs_[bottom & kMask].load(std::memory_order_relaxed);
+
+    if (top == bottom) {
+      // The last job, a thief may be taking it as well
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        job = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return job;
+  }
+
+  // Any thread, the job pushed first
+  Job* Steal() {
+    auto top = top_.load(std::memory_order_acquire);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const auto bottom = bottom_.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+      return nullptr;
+    }
+    auto job = jobs_[top & kMask].load(std::memory_order_relaxed);
+
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return job;
+  }
+
+  inline bool IsEmpty() const {
+    return top_.load(std::memory_order_relaxed) >= bottom_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr int64_t kMask = kCapacity - 1;
+
+  alignas(64) std::atomic<int64_t> top_ = 0;
+  alignas(64) std::atomic<int64_t> bottom_ = 0;
+  std::atomic<Job*> jobs_[kCapacity] = {};
+};
+
+// Work stealing scheduler. Every worker thread has a deque of its own, jobs forked by a worker
+// go on its deque and idle workers steal from the others. A thread that is not a worker takes
+// the first worker slot and runs jobs while it waits for a task group, only one such thread
+// may use the job system at a time. Job slots are reused round robin once their job is done, a
+// job that would take a slot still in flight runs on the submitting thread instead.
+class JobSystem final {
+ public:
+  // Fork/join group, Wait() returns when every job run in the group is done
+  class TaskGroup final {
+   public:
+    TaskGroup() = default;
+
+    TaskGroup(const TaskGroup&) = delete;
+
+    inline bool IsDone() const { return 0 == pending_.load(std::memory_order_acquire); }
+
+   private:
+    friend class JobSystem;
+
+    std::atomic<size_t> pending_ = 0;
+  };
+
+  static constexpr size_t kMaxJobs = WorkStealingDeque::kCapacity;
+
+  // Zero workers uses one per physical core. Workers are pinned to a physical core each
+  // where it is supported, when there are more workers than cores they share them.
+  explicit JobSystem(size_t workers = 0, bool pin = true);
+
+  JobSystem(const JobSystem&) = delete;
+
+  ~JobSystem() noexcept;
+
+  // Runs function() as a job of the group, function must stay alive until the group is done
+  template<typename Function>
+  void Run(TaskGroup& group, Function& function) {
+    Submit(&group.pending_, [](Job& job) { (*static_cast<Function*>(job.context))(); }, &function, 0, 0);
+  }
+
+  // Runs jobs, on this thread as well, until every job in the group is done
+  void Wait(TaskGroup& group);
+
+  // Calls function(first, last) over [begin, end) split into ranges of at most grain indices,
+  // ranges are split in half as they are stolen. Returns when the whole range is done.
+  template<typename Function>
+  void ParallelFor(size_t begin, size_t end, size_t grain, Function& function) {
+    TaskGroup group;
+
+    Submit(&group.pending_, &Split<Function>, &function, begin, end, std::max<size_t>(grain, 1));
+    Wait(group);
+  }
+
+  // Workers, the thread outside of them that waits for jobs included
+  inline size_t size() const { return workers_.size(); }
+
+  // The first logical CPU of every physical core, all logical CPUs if the topology is unknown
+  static std::vector<int> PhysicalCores();
+
+ protected:
+  struct Worker {
+    WorkStealingDeque deque;
+    std::unique_ptr<Job[]> jobs = std::make_unique<Job[]>(kMaxJobs);
+    size_t next_job = 0;
+    std::thread thread;
+  };
+
+  template<typename Function>
+  static void Split(Job& job) {
+    auto begin = job.begin;
+    auto end = job.end;
+
+    // Hand out the upper half until the rest is small enough to run here
+    while (end - begin > job.grain) {
+      const auto middle = begin + (end - begin) / 2;
+
+      job.system->Submit(job.pending, &Split<Function>, job.context, middle, end, job.grain);
+      end = middle;
+    }
+    (*static_cast<Function*>(job.context))(begin, end);
+  }
+
+  void Submit(std::atomic<size_t>* pending, void (*function)(Job&), void* context, size_t begin, size_t end,
+              size_t grain = 0);
+
+  // This thread's worker, 0 for threads outside the job system
+  size_t index() const;
+
+  Job* FindJob(size_t index);
+
+  bool HasJobs() const;
+
+  void Execute(Job* job);
+
+  void WorkerLoop(size_t index);
+
+ private:
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<bool> quit_ = false;
+  std::atomic<int> sleeping_ = 0;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+};
+
+} // namespace utility
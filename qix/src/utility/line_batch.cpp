@@ -0,0 +1,57 @@
+#include "utility/line_batch.h"
+
+#include <cmath>
+#include <tuple>
+#include <algorithm>
+
+namespace {
+
+const float kHalfLineWidth = 0.5f;
+
+}  // namespace
+
+namespace utility {
+
+void LineBatch::Render(SDL_Renderer* renderer) {
+  if (segments_.empty()) {
+    return;
+  }
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  vertices_.clear();
+  for (const auto& s : segments_) {
+    const float dx = s.p2.x - s.p1.x;
+    const float dy = s.p2.y - s.p1.y;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    const float nx = (length > 0.0f) ? -dy / length * kHalfLineWidth : kHalfLineWidth;
+    const float ny = (length > 0.0f) ? dx / length * kHalfLineWidth : 0.0f;
+    const auto color = GetColor(s.color);
+
+    vertices_.push_back({ { s.p1.x + nx, s.p1.y + ny }, color, { 0.0f, 0.0f } });
+    vertices_.push_back({ { s.p1.x - nx, s.p1.y - ny }, color, { 0.0f, 0.0f } });
+    vertices_.push_back({ { s.p2.x + nx, s.p2.y + ny }, color, { 0.0f, 0.0f } });
+    vertices_.push_back({ { s.p2.x - nx, s.p2.y - ny }, color, { 0.0f, 0.0f } });
+  }
+  // Every quad uses the same index pattern, so the index buffer only ever has to grow
+  for (int i = static_cast<int>(indices_.size() / 6) * 4; i < static_cast<int>(vertices_.size()); i += 4) {
+    indices_.insert(indices_.end(), { i, i + 1, i + 2, i + 1, i + 3, i + 2 });
+  }
+  SDL_RenderGeometry(renderer, nullptr, vertices_.data(), static_cast<int>(vertices_.size()), indices_.data(),
+                     static_cast<int>(segments_.size() * 6));
+#else
+  // No geometry API, at least change draw color only once per color
+  std::stable_sort(segments_.begin(), segments_.end(), [](const auto& a, const auto& b) { return a.color < b.color; });
+
+  auto color = Color::None;
+
+  for (const auto& s : segments_) {
+    if (s.color != color) {
+      color = s.color;
+      std::apply([](auto &&... args) { SetColor(args...); }, UnpackColor(renderer, color));
+    }
+    SDL_RenderDrawLineF(renderer, s.p1.x, s.p1.y, s.p2.x, s.p2.y);
+  }
+#endif
+  segments_.clear();
+}
+
+} // namespace utility
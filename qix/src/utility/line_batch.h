@@ -0,0 +1,45 @@
+#pragma once
+
+#include "utility/color.h"
+
+#include <SDL.h>
+
+#include <vector>
+
+namespace utility {
+
+// Collects line segments during a frame and draws them all at once. With SDL 2.0.18 or later
+// every segment becomes a one pixel wide quad in a shared vertex buffer, and the whole batch
+// is a single SDL_RenderGeometry call regardless of how many segments or colors it holds.
+class LineBatch final {
+ public:
+  LineBatch() = default;
+
+  LineBatch(const LineBatch&) = delete;
+
+  inline void Add(float x1, float y1, float x2, float y2, Color color) {
+    segments_.push_back({ { x1, y1 }, { x2, y2 }, color });
+  }
+
+  // Draws and clears the batch, all buffers keep their capacity for the next frame
+  void Render(SDL_Renderer* renderer);
+
+  inline void Clear() { segments_.clear(); }
+
+  inline bool IsEmpty() const { return segments_.empty(); }
+
+  inline size_t size() const { return segments_.size(); }
+
+ private:
+  struct Segment {
+    SDL_FPoint p1;
+    SDL_FPoint p2;
+    Color color;
+  };
+
+  std::vector<Segment> segments_;
+  std::vector<SDL_Vertex> vertices_;
+  std::vector<int> indices_;
+};
+
+} // namespace utility
@@ -11,17 +11,17 @@ const Font kFontItem = Font(Font::Typeface::ObelixPro, Font::Emphasis::Normal, 1
 
 namespace utility {
 
-MenuView::MenuView(SDL_Renderer* renderer, const SDL_Rect& rc, const std::shared_ptr<Fonts>& fonts,
+MenuView::MenuView(const SDL_Rect& rc, const std::shared_ptr<GlyphAtlas>& atlas,
                    const std::shared_ptr<MenuModel>& menu_model, MenuAction* menu_action)
-    : renderer_(renderer), rc_(rc), fonts_(fonts), menu_model_(menu_model), selected_item_(menu_model->GetSelected()), menu_action_(menu_action) {
+    : rc_(rc), atlas_(atlas), menu_model_(menu_model), selected_item_(menu_model->GetSelected()), menu_action_(menu_action) {
   menu_model_->SetActionListener(this);
   const std::vector<std::string> kStrings = {"[", "]"};
 
   for (const auto& str : kStrings) {
     auto s = std::make_shared<Selection>();
 
-    std::tie(s->texture_, s->rc_.w, s->rc_.h) =
-        CreateTextureFromText(renderer_, fonts_->Get(kFontItem), str, Color::SteelGray);
+    s->text_ = str;
+    std::tie(s->rc_.w, s->rc_.h) = atlas_->Measure(kFontItem, str);
     selection_.emplace_back(s);
   }
   for (int i = 0; i < static_cast<int>(menu_model_->size()); ++i) {
@@ -40,16 +40,17 @@ void MenuView::Render() {
       auto& left = selection_.at(Left);
       left->rc_.x = item->rc_.x - (left->rc_.w + 10);
       left->rc_.y = offset;
-      SDL_RenderCopy(renderer_, left->texture_.get(), nullptr, &left->rc_);
+      atlas_->Add(kFontItem, left->rc_.x, left->rc_.y, left->text_, Color::SteelGray);
       auto& right = selection_.at(Right);
       right->rc_.x = item->rc_.x + (item->rc_.w + 10);
       right->rc_.y = offset;
-      SDL_RenderCopy(renderer_, right->texture_.get(), nullptr, &right->rc_);
+      atlas_->Add(kFontItem, right->rc_.x, right->rc_.y, right->text_, Color::SteelGray);
     }
-    SDL_RenderCopy(renderer_, item->texture_.get(), nullptr, &item->rc_);
+    atlas_->Add(item->font_, item->rc_.x, item->rc_.y, item->text_, item->color_);
     offset += item->rc_.h + ((MenuModel::MenuItemType::Name == item->type_) ? 10 : 25);
     pos++;
   }
+  atlas_->Render();
 }
 
 void MenuView::ItemSelected(size_t item) {
@@ -72,10 +73,9 @@ std::shared_ptr<MenuView::MenuItem> MenuView::CreateItem(size_t item_nr) {
   auto font = (MenuModel::MenuItemType::Name == type) ? kFontName : kFontItem;
   auto color = (MenuModel::MenuItemType::Name == type) ? Color::White : Color::Yellow;
 
-  auto item = std::make_shared<MenuItem>(type);
+  auto item = std::make_shared<MenuItem>(type, font, text, color);
 
-  std::tie(item->texture_, item->rc_.w, item->rc_.h) =
-      CreateTextureFromText(renderer_, fonts_->Get(font), text, color);
+  std::tie(item->rc_.w, item->rc_.h) = atlas_->Measure(font, text);
 
   item->rc_.x = rc_.x + Center(rc_.w, item->rc_.w);
 
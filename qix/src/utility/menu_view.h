@@ -1,15 +1,14 @@
 #pragma once
 
-#include "utility/text.h"
-#include "utility/fonts.h"
+#include "utility/glyph_atlas.h"
 #include "utility/menu_model.h"
 
 namespace utility {
 
 class MenuView : protected MenuAction {
  public:
-  MenuView(SDL_Renderer* renderer, const SDL_Rect& rc, const std::shared_ptr<Fonts>& fonts,
-           const std::shared_ptr<MenuModel>& menu_model, MenuAction* menu_action);
+  MenuView(const SDL_Rect& rc, const std::shared_ptr<GlyphAtlas>& atlas, const std::shared_ptr<MenuModel>& menu_model,
+           MenuAction* menu_action);
 
   virtual ~MenuView() noexcept {}
 
@@ -25,25 +24,27 @@ class MenuView : protected MenuAction {
   virtual void ItemChanged(size_t item) override;
 
   struct MenuItem {
-    explicit MenuItem(MenuModel::MenuItemType type) : type_(type), rc_{} {}
+    MenuItem(MenuModel::MenuItemType type, const Font& font, const std::string& text, Color color)
+        : type_(type), font_(font), text_(text), color_(color), rc_{} {}
     MenuModel::MenuItemType type_;
-    UniqueTexturePtr texture_;
+    Font font_;
+    std::string text_;
+    Color color_;
     SDL_Rect rc_;
   };
 
   enum { Left, Right };
 
   struct Selection {
-    UniqueTexturePtr texture_;
+    std::string text_;
     SDL_Rect rc_;
   };
 
   std::shared_ptr<MenuItem> CreateItem(size_t item);
 
  private:
-  SDL_Renderer* renderer_;
   SDL_Rect rc_;
-  std::shared_ptr<Fonts> fonts_;
+  std::shared_ptr<GlyphAtlas> atlas_;
   std::vector<std::shared_ptr<Selection>> selection_;
   std::vector<std::shared_ptr<MenuItem>> items_;
   std::shared_ptr<MenuModel> menu_model_;
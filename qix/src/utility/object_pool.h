@@ -0,0 +1,126 @@
+#pragma once
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+namespace utility {
+
+// Refers to an object in an ObjectPool. The generation tells a handle to a destroyed object
+// apart from one to the object that reused its slot.
+struct PoolHandle {
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+  uint32_t index = kInvalidIndex;
+  uint32_t generation = 0;
+
+  inline bool is_valid() const { return kInvalidIndex != index; }
+
+  inline bool operator==(const PoolHandle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+};
+
+// Fixed capacity arena of objects of one type. All storage is allocated up front, creating and
+// destroying objects only pops and pushes slot indices on a free list. Pointers stay valid
+// until the object is destroyed.
+template<typename T>
+class ObjectPool final {
+ public:
+  using Handle = PoolHandle;
+
+  explicit ObjectPool(size_t capacity) : capacity_(capacity), slots_(std::make_unique<Slot[]>(capacity)) {
+    free_.reserve(capacity);
+    for (size_t i = capacity; i > 0; --i) {
+      free_.push_back(static_cast<uint32_t>(i - 1));
+    }
+  }
+
+  ObjectPool(const ObjectPool&) = delete;
+
+  ~ObjectPool() noexcept { Reset(); }
+
+  // Returns an invalid handle if the pool is full
+  template<class ...Args>
+  Handle Create(Args&&... args) {
+    if (free_.empty()) {
+      return Handle();
+    }
+    const auto index = free_.back();
+    auto& slot = slots_[index];
+
+    free_.pop_back();
+    new (slot.storage) T(std::forward<Args>(args)...);
+    slot.alive = true;
+
+    return { index, slot.generation };
+  }
+
+  // Returns nullptr if the object has been destroyed
+  T* Get(Handle handle) const {
+    if (handle.index >= capacity_) {
+      return nullptr;
+    }
+    auto& slot = slots_[handle.index];
+
+    return (slot.alive && slot.generation == handle.generation) ? slot.object() : nullptr;
+  }
+
+  bool Destroy(Handle handle) {
+    if (nullptr == Get(handle)) {
+      return false;
+    }
+    Release(handle.index);
+
+    return true;
+  }
+
+  // Destroys every object, the storage is kept for the next level
+  void Reset() {
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (slots_[i].alive) {
+        Release(static_cast<uint32_t>(i));
+      }
+    }
+  }
+
+  // Visits the live objects in slot order
+  template<typename Function>
+  void ForEach(Function function) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (slots_[i].alive) {
+        function(*slots_[i].object());
+      }
+    }
+  }
+
+  inline size_t size() const { return capacity_ - free_.size(); }
+
+  inline size_t capacity() const { return capacity_; }
+
+ protected:
+  struct Slot {
+    alignas(T) unsigned char storage[sizeof(T)];
+    uint32_t generation = 0;
+    bool alive = false;
+
+    inline T* object() { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+  void Release(uint32_t index) {
+    auto& slot = slots_[index];
+
+    slot.object()->~T();
+    slot.alive = false;
+    slot.generation++;
+    free_.push_back(index);
+  }
+
+ private:
+  size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::vector<uint32_t> free_;
+};
+
+} // namespace utility
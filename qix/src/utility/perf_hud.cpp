@@ -0,0 +1,115 @@
+#include "utility/perf_hud.h"
+#include "utility/alloc_counter.h"
+
+#include <cstdio>
+
+namespace {
+
+using namespace utility;
+
+const Font kFontHud = Font(Font::Typeface::Cabin, Font::Emphasis::Normal, 14);
+const SDL_Rect kHudRect = { 8, 8, 300, 230 };
+const SDL_Rect kGraphRect = { 16, 140, 284, 90 };
+const int kLineHeight = 20;
+const int64_t kTextUpdateInterval = 250; // milliseconds
+const float kGraphRange = 1000.0f / 30.0f; // milliseconds at the top of the graph
+const float kFrameBudget = 1000.0f / 60.0f; // milliseconds
+
+constexpr std::array<Profiler::Phase, 5> kPhases = {
+  Profiler::Phase::Frame, Profiler::Phase::Input, Profiler::Phase::Update, Profiler::Phase::Render, Profiler::Phase::Present
+};
+
+float GraphY(float ms) {
+  return kGraphRect.y + kGraphRect.h - std::min(ms / kGraphRange, 1.0f) * kGraphRect.h;
+}
+
+}  // namespace
+
+namespace utility {
+
+PerfHud::PerfHud(SDL_Renderer* renderer, const std::shared_ptr<GlyphAtlas>& atlas)
+    : renderer_(renderer), atlas_(atlas),
+      panel_(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, kHudRect.w, kHudRect.h)) {
+  atlas_->Preload({ kFontHud });
+  samples_.reserve(TimingRing::kCapacity);
+  if (panel_) {
+    SDL_SetTextureBlendMode(panel_.get(), SDL_BLENDMODE_BLEND);
+  }
+}
+
+void PerfHud::Render(const Profiler& profiler) {
+  if (!visible_) {
+    return;
+  }
+  if (time_in_ms() - last_text_update_ >= kTextUpdateInterval) {
+    UpdateText(profiler);
+    last_text_update_ = time_in_ms();
+    if (panel_) {
+      SDL_SetRenderTarget(renderer_, panel_.get());
+      SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 0);
+      SDL_RenderClear(renderer_);
+      RenderPanel(0, 0);
+      SDL_SetRenderTarget(renderer_, nullptr);
+    }
+  }
+  if (panel_) {
+    SDL_RenderCopy(renderer_, panel_.get(), nullptr, &kHudRect);
+  } else {
+    RenderPanel(kHudRect.x, kHudRect.y);
+  }
+  RenderGraph(profiler);
+}
+
+void PerfHud::RenderPanel(int x, int y) {
+  const SDL_Rect rc = { x, y, kHudRect.w, kHudRect.h };
+
+  // Blending is left to the copy of the panel when it is cached
+  SDL_SetRenderDrawBlendMode(renderer_, panel_ ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+  std::apply([](auto &&... args) { SetColor(args...); }, UnpackColor(renderer_, Color::Black, 192));
+  SDL_RenderFillRect(renderer_, &rc);
+  SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_NONE);
+
+  y += 4;
+  for (size_t i = 0; i < line_count_; ++i) {
+    atlas_->Add(kFontHud, x + 8, y, lines_[i].data(), Color::White);
+    y += kLineHeight;
+  }
+  atlas_->Render();
+}
+
+void PerfHud::UpdateText(const Profiler& profiler) {
+  static_assert(kPhases.size() < kMaxLines, "No line left for the allocations");
+
+  line_count_ = 0;
+  for (auto phase : kPhases) {
+    const auto stats = profiler.GetStats(phase, samples_);
+
+    std::snprintf(lines_[line_count_++].data(), kLineLength, "%-8sp50 %.2f  p99 %.2f  max %.2f ms",
+                  ToString(phase).c_str(), stats.p50, stats.p99, stats.max);
+  }
+  if (kCountAllocations) {
+    std::snprintf(lines_[line_count_++].data(), kLineLength, "Allocs  %llu last frame",
+                  static_cast<unsigned long long>(profiler.allocations()));
+  }
+}
+
+void PerfHud::RenderGraph(const Profiler& profiler) {
+  const float left = static_cast<float>(kGraphRect.x);
+  const float right = static_cast<float>(kGraphRect.x + kGraphRect.w);
+
+  batch_.Add(left, GraphY(kFrameBudget), right, GraphY(kFrameBudget), Color::Yellow);
+
+  profiler.Snapshot(Profiler::Phase::Frame, samples_);
+
+  const auto count = std::min<size_t>(samples_.size(), kGraphRect.w);
+  const auto first = samples_.size() - count;
+
+  for (size_t i = 1; i < count; ++i) {
+    const float x = right - (count - i);
+
+    batch_.Add(x - 1.0f, GraphY(samples_[first + i - 1]), x, GraphY(samples_[first + i]), Color::Green);
+  }
+  batch_.Render(renderer_);
+}
+
+} // namespace utility
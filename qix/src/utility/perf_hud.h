@@ -0,0 +1,56 @@
+#pragma once
+
+#include "utility/text.h"
+#include "utility/glyph_atlas.h"
+#include "utility/profiler.h"
+#include "utility/line_batch.h"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace utility {
+
+// Overlay with p50/p99/max of every profiler phase, the heap allocations of the last frame in
+// debug builds and a graph of the most recent frame times. The numbers are only updated a few
+// times per second, the panel with the text is then drawn into a texture that is copied every
+// frame. Only the graph is drawn every frame. The text is formatted into fixed buffers, the HUD
+// does not add to the allocations it reports.
+class PerfHud final {
+ public:
+  PerfHud(SDL_Renderer* renderer, const std::shared_ptr<GlyphAtlas>& atlas);
+
+  PerfHud(const PerfHud&) = delete;
+
+  // May be called from another thread than the one rendering
+  inline void Toggle() { visible_ = !visible_; }
+
+  inline bool IsVisible() const { return visible_; }
+
+  void Render(const Profiler& profiler);
+
+ protected:
+  void UpdateText(const Profiler& profiler);
+
+  // Draws the background and the text with the top left corner at x, y
+  void RenderPanel(int x, int y);
+
+  void RenderGraph(const Profiler& profiler);
+
+ private:
+  SDL_Renderer* renderer_;
+  std::shared_ptr<GlyphAtlas> atlas_;
+  // Nullptr if the renderer cannot render to textures, the panel is then drawn every frame
+  UniqueTexturePtr panel_;
+  std::atomic<bool> visible_ = false;
+  int64_t last_text_update_ = 0;
+  static constexpr size_t kMaxLines = 6;
+  static constexpr size_t kLineLength = 64;
+
+  std::array<std::array<char, kLineLength>, kMaxLines> lines_ = {};
+  size_t line_count_ = 0;
+  std::vector<float> samples_;
+  LineBatch batch_;
+};
+
+} // namespace utility
@@ -0,0 +1,57 @@
+#include "utility/profiler.h"
+
+#include <algorithm>
+
+namespace {
+
+float Percentile(std::vector<float>& samples, double percentile) {
+  const auto n = static_cast<size_t>(percentile * (samples.size() - 1) + 0.5);
+
+  std::nth_element(samples.begin(), samples.begin() + n, samples.end());
+
+  return samples[n];
+}
+
+}  // namespace
+
+namespace utility {
+
+Profiler::Stats Profiler::GetStats(Phase phase) const {
+  std::vector<float> samples;
+
+  return GetStats(phase, samples);
+}
+
+Profiler::Stats Profiler::GetStats(Phase phase, std::vector<float>& samples) const {
+  Snapshot(phase, samples);
+  if (samples.empty()) {
+    return {};
+  }
+  Stats stats;
+
+  stats.max = *std::max_element(samples.begin(), samples.end());
+  stats.p99 = Percentile(samples, 0.99);
+  stats.p50 = Percentile(samples, 0.50);
+
+  return stats;
+}
+
+std::string ToString(Profiler::Phase phase) {
+  switch (phase) {
+    case Profiler::Phase::Input:
+      return "Input";
+    case Profiler::Phase::Update:
+      return "Update";
+    case Profiler::Phase::Render:
+      return "Render";
+    case Profiler::Phase::Present:
+      return "Present";
+    case Profiler::Phase::Frame:
+      return "Frame";
+    case Profiler::Phase::Count:
+      break;
+  }
+  return "";
+}
+
+} // namespace utility
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "utility/timer.h"
+
+#include <array>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+namespace utility {
+
+// Keeps the last kCapacity samples. One thread records while any other thread may take a
+// snapshot at the same time, neither side ever takes a lock. A snapshot racing with the
+// writer can include a sample that was just overwritten, which is fine for statistics.
+class TimingRing final {
+ public:
+  static constexpr size_t kCapacity = 512;
+
+  TimingRing() {
+    for (auto& sample : samples_) {
+      sample.store(0.0f, std::memory_order_relaxed);
+    }
+  }
+
+  TimingRing(const TimingRing&) = delete;
+
+  inline void Record(float ms) {
+    const auto head = head_.load(std::memory_order_relaxed);
+
+    samples_[head % kCapacity].store(ms, std::memory_order_relaxed);
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Copies the recorded samples, oldest first
+  void Snapshot(std::vector<float>& samples) const {
+    const auto head = head_.load(std::memory_order_acquire);
+    const auto count = std::min<uint64_t>(head, kCapacity);
+
+    samples.clear();
+    for (auto i = head - count; i < head; ++i) {
+      samples.push_back(samples_[i % kCapacity].load(std::memory_order_relaxed));
+    }
+  }
+
+  inline uint64_t count() const { return head_.load(std::memory_order_acquire); }
+
+ private:
+  std::array<std::atomic<float>, kCapacity> samples_;
+  std::atomic<uint64_t> head_ = 0;
+};
+
+class Profiler final {
+ public:
+  enum class Phase { Input, Update, Render, Present, Frame, Count };
+
+  struct Stats {
+    float p50 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+  };
+
+  Profiler() = default;
+
+  Profiler(const Profiler&) = delete;
+
+  inline void Record(Phase phase, double seconds) { rings_[index(phase)].Record(static_cast<float>(seconds * 1000.0)); }
+
+  inline void Snapshot(Phase phase, std::vector<float>& samples) const { rings_[index(phase)].Snapshot(samples); }
+
+  // Milliseconds over the samples kept for the phase
+  Stats GetStats(Phase phase) const;
+
+  // As above with samples as scratch space, a vector kept between calls stops allocating
+  Stats GetStats(Phase phase, std::vector<float>& samples) const;
+
+  // Heap allocations made during the last frame
+  inline void RecordAllocations(uint64_t count) { allocations_.store(count, std::memory_order_relaxed); }
+
+  inline uint64_t allocations() const { return allocations_.load(std::memory_order_relaxed); }
+
+ protected:
+  static inline size_t index(Phase phase) { return static_cast<size_t>(phase); }
+
+ private:
+  std::array<TimingRing, static_cast<size_t>(Phase::Count)> rings_;
+  std::atomic<uint64_t> allocations_ = 0;
+};
+
+std::string ToString(Profiler::Phase phase);
+
+// Records the time from construction to destruction as one sample of a phase
+class ScopedTimer final {
+ public:
+  ScopedTimer(Profiler& profiler, Profiler::Phase phase) : profiler_(profiler), phase_(phase) {}
+
+  ScopedTimer(const ScopedTimer&) = delete;
+
+  ~ScopedTimer() noexcept { profiler_.Record(phase_, timer_.GetDelta()); }
+
+ private:
+  Profiler& profiler_;
+  Profiler::Phase phase_;
+  DeltaTimer timer_;
+};
+
+} // namespace utility
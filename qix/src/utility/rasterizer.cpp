@@ -0,0 +1,102 @@
+#include "utility/rasterizer.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define QIX_RASTERIZER_SSE2
+#endif
+
+namespace {
+
+const int kCellsPerWord = 32;
+const uint64_t kRepeatCell = 0x5555555555555555ull;
+
+// Writes 32 pixels from a word of mixed cells, each pixel taken from the pattern line of its cell
+void RenderWord(uint32_t* out, const std::array<const uint32_t*, 4>& lines, int x, uint64_t word) {
+#if defined(QIX_RASTERIZER_SSE2)
+  const __m128i codes[4] = { _mm_set1_epi32(0), _mm_set1_epi32(1), _mm_set1_epi32(2), _mm_set1_epi32(3) };
+
+  for (int i = 0; i < kCellsPerWord; i += 4, word >>= 8) {
+    const auto bits = static_cast<int>(word & 0xff);
+    const __m128i cells = _mm_set_epi32((bits >> 6) & 3, (bits >> 4) & 3, (bits >> 2) & 3, bits & 3);
+    __m128i pixels = _mm_setzero_si128();
+
+    for (size_t p = 0; p < lines.size(); ++p) {
+      const __m128i mask = _mm_cmpeq_epi32(cells, codes[p]);
+      const __m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lines[p] + x + i));
+
+      pixels = _mm_or_si128(pixels, _mm_and_si128(mask, colors));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), pixels);
+  }
+#else
+  for (int i = 0; i < kCellsPerWord; ++i, word >>= 2) {
+    out[i] = lines[word & 3][x + i];
+  }
+#endif
+}
+
+}  // namespace
+
+namespace utility {
+
+Rasterizer::Rasterizer(int width, int height, const std::array<Pattern, 4>& patterns, JobSystem& jobs)
+    : width_(width), height_(height), pixels_(static_cast<size_t>(width) * height), jobs_(jobs) {
+  for (size_t p = 0; p < patterns.size(); ++p) {
+    const auto& pattern = patterns[p];
+    auto& line = lines_[p];
+
+    spacing_[p] = pattern.hatch_spacing;
+    line.resize(static_cast<size_t>(width_ + pattern.hatch_spacing));
+    for (size_t x = 0; x < line.size(); ++x) {
+      const bool hatch = pattern.hatch_spacing > 0 && 0 == x % pattern.hatch_spacing;
+
+      line[x] = hatch ? pattern.hatch_color : pattern.color;
+    }
+  }
+}
+
+void Rasterizer::Render(const uint64_t* cells, int words_per_row, const std::vector<SDL_Rect>& rects) {
+  auto render = [this, cells, words_per_row, &rects](size_t first, size_t last) {
+    for (auto i = first; i < last; ++i) {
+      const auto& rc = rects[i];
+
+      for (int y = rc.y; y < rc.y + rc.h; ++y) {
+        RenderRow(cells + static_cast<size_t>(y) * words_per_row, y, rc.x, rc.x + rc.w);
+      }
+    }
+  };
+
+  jobs_.ParallelFor(0, rects.size(), 1, render);
+}
+
+void Rasterizer::RenderRow(const uint64_t* words, int y, int x1, int x2) {
+  uint32_t* out = &pixels_[static_cast<size_t>(y) * width_];
+  std::array<const uint32_t*, 4> lines;
+
+  // Hatch lines run diagonally, pixel x of row y is pixel x + y of the pattern line
+  for (size_t p = 0; p < lines.size(); ++p) {
+    lines[p] = lines_[p].data() + (spacing_[p] > 0 ? y % spacing_[p] : 0);
+  }
+  int x = x1;
+
+  while (x < x2) {
+    if (0 == x % kCellsPerWord && x + kCellsPerWord <= x2) {
+      const uint64_t word = words[x / kCellsPerWord];
+      const uint64_t cell = word & 3;
+
+      if (word == cell * kRepeatCell) {
+        std::memcpy(out + x, lines[cell] + x, kCellsPerWord * sizeof(uint32_t));
+      } else {
+        RenderWord(out + x, lines, x, word);
+      }
+      x += kCellsPerWord;
+    } else {
+      out[x] = lines[(words[x / kCellsPerWord] >> ((x % kCellsPerWord) * 2)) & 3][x];
+      x++;
+    }
+  }
+}
+
+} // namespace utility
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "utility/job_system.h"
+
+#include <SDL.h>
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace utility {
+
+// Renders a grid of 2 bit cells, 32 to a 64 bit word as Grid packs them, into an RGBA8888
+// buffer on the CPU. Every cell value has a pattern, a solid color or one with diagonal hatch
+// lines. Rectangles are rendered in parallel on the job system, a word of 32 equal cells
+// is a single copy and mixed words are converted four pixels at a time with SSE2 when there is.
+class Rasterizer final {
+ public:
+  struct Pattern {
+    uint32_t color = 0;
+    uint32_t hatch_color = 0;
+    // Pixels between hatch lines, 0 is a solid fill
+    int hatch_spacing = 0;
+  };
+
+  Rasterizer(int width, int height, const std::array<Pattern, 4>& patterns, JobSystem& jobs);
+
+  Rasterizer(const Rasterizer&) = delete;
+
+  // Renders the cells covered by the rectangles, which must not overlap. Row y of the cells
+  // starts at cells + y * words_per_row.
+  void Render(const uint64_t* cells, int words_per_row, const std::vector<SDL_Rect>& rects);
+
+  inline const uint32_t* row(int y) const { return &pixels_[static_cast<size_t>(y) * width_]; }
+
+  inline int width() const { return width_; }
+
+  inline int height() const { return height_; }
+
+ protected:
+  void RenderRow(const uint64_t* words, int y, int x1, int x2);
+
+ private:
+  int width_;
+  int height_;
+  // A row of every pattern, wide enough to start at any hatch offset
+  std::array<std::vector<uint32_t>, 4> lines_;
+  std::array<int, 4> spacing_;
+  std::vector<uint32_t> pixels_;
+  JobSystem& jobs_;
+};
+
+} // namespace utility
@@ -0,0 +1,120 @@
+#include "utility/render_commands.h"
+
+#include <tuple>
+
+namespace utility {
+
+void CommandBuffer::AddText(const Font& font, int x, int y, std::string_view text, Color color) {
+  const auto index = static_cast<uint32_t>(texts_.size());
+
+  texts_.push_back({ font, static_cast<uint32_t>(characters_.size()), static_cast<uint32_t>(text.size()) });
+  characters_.insert(characters_.end(), text.begin(), text.end());
+  AddRectangle(Type::Text, { x, y, 0, 0 }, color, 255, nullptr, index);
+}
+
+uint32_t* CommandBuffer::AddUpload(SDL_Texture* texture, const SDL_Rect& rc) {
+  const auto index = static_cast<uint32_t>(uploads_.size());
+  const auto offset = pixels_.size();
+
+  uploads_.push_back({ rc, static_cast<uint32_t>(offset) });
+  pixels_.resize(offset + rc.w * rc.h);
+  AddRectangle(Type::Upload, rc, Color::White, 255, texture, index);
+
+  return pixels_.data() + offset;
+}
+
+void CommandBuffer::Append(const CommandBuffer& other) {
+  const auto texts = static_cast<uint32_t>(texts_.size());
+  const auto uploads = static_cast<uint32_t>(uploads_.size());
+  const auto characters = static_cast<uint32_t>(characters_.size());
+  const auto pixels = static_cast<uint32_t>(pixels_.size());
+
+  for (auto command : other.commands_) {
+    if (Type::Text == command.type) {
+      command.index += texts;
+    } else if (Type::Upload == command.type) {
+      command.index += uploads;
+    }
+    commands_.push_back(command);
+  }
+  for (auto text : other.texts_) {
+    text.offset += characters;
+    texts_.push_back(text);
+  }
+  for (auto upload : other.uploads_) {
+    upload.offset += pixels;
+    uploads_.push_back(upload);
+  }
+  characters_.insert(characters_.end(), other.characters_.begin(), other.characters_.end());
+  pixels_.insert(pixels_.end(), other.pixels_.begin(), other.pixels_.end());
+  unchanged_ = unchanged_ && other.unchanged_;
+}
+
+void CommandBuffer::Clear() {
+  commands_.clear();
+  texts_.clear();
+  characters_.clear();
+  uploads_.clear();
+  pixels_.clear();
+  unchanged_ = false;
+}
+
+void CommandRenderer::Flush(CommandBuffer::Type next) {
+  if (CommandBuffer::Type::Line != next) {
+    batch_.Render(renderer_);
+  }
+  if (CommandBuffer::Type::Text != next && has_text_) {
+    atlas_->Render();
+    has_text_ = false;
+  }
+}
+
+void CommandRenderer::Submit(const CommandBuffer& buffer) {
+  for (const auto& command : buffer.commands()) {
+    Flush(command.type);
+    switch (command.type) {
+      case CommandBuffer::Type::Line:
+        batch_.Add(command.x1, command.y1, command.x2, command.y2, command.color);
+        break;
+      case CommandBuffer::Type::Rect:
+      case CommandBuffer::Type::FillRect: {
+        const SDL_FRect rc = { command.x1, command.y1, command.x2, command.y2 };
+
+        if (command.alpha < 255) {
+          SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_BLEND);
+        }
+        std::apply([](auto &&... args) { SetColor(args...); }, UnpackColor(renderer_, command.color, command.alpha));
+        if (CommandBuffer::Type::Rect == command.type) {
+          SDL_RenderDrawRectF(renderer_, &rc);
+        } else {
+          SDL_RenderFillRectF(renderer_, &rc);
+        }
+        SDL_SetRenderDrawBlendMode(renderer_, SDL_BLENDMODE_NONE);
+        break;
+      }
+      case CommandBuffer::Type::Copy: {
+        const SDL_FRect rc = { command.x1, command.y1, command.x2, command.y2 };
+
+        SDL_RenderCopyF(renderer_, command.texture, nullptr, &rc);
+        break;
+      }
+      case CommandBuffer::Type::Text:
+        if (atlas_) {
+          atlas_->Add(buffer.font(command), static_cast<int>(command.x1), static_cast<int>(command.y1),
+                      buffer.text(command), command.color);
+          has_text_ = true;
+        }
+        break;
+      case CommandBuffer::Type::Upload: {
+        const auto& upload = buffer.upload(command);
+
+        SDL_UpdateTexture(command.texture, &upload.rc, buffer.pixels(command), upload.rc.w * sizeof(uint32_t));
+        break;
+      }
+    }
+  }
+  // Neither a line nor text follows, everything still batched is drawn
+  Flush(CommandBuffer::Type::Upload);
+}
+
+} // namespace utility
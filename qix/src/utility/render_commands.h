@@ -0,0 +1,144 @@
+#pragma once
+
+#include "utility/color.h"
+#include "utility/fonts.h"
+#include "utility/line_batch.h"
+#include "utility/glyph_atlas.h"
+
+#include <SDL.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+namespace utility {
+
+// Draw commands recorded without calling SDL, so any thread can record them. A buffer is only
+// used by one thread at a time, threads recording in parallel use a buffer each and Append()
+// them in the order they should be drawn. Everything a buffer holds keeps its capacity when
+// cleared, a buffer reused every frame stops allocating.
+class CommandBuffer final {
+ public:
+  enum class Type : uint8_t { Line, Rect, FillRect, Copy, Text, Upload };
+
+  struct Command {
+    Type type;
+    uint8_t alpha;
+    Color color;
+    // Index into the text or upload records
+    uint32_t index;
+    SDL_Texture* texture;
+    // End points of a line, or x, y, width and height of a rectangle
+    float x1;
+    float y1;
+    float x2;
+    float y2;
+  };
+
+  struct Text {
+    Font font;
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  struct Upload {
+    SDL_Rect rc;
+    uint32_t offset;
+  };
+
+  CommandBuffer() = default;
+
+  CommandBuffer(const CommandBuffer&) = delete;
+
+  inline void Add(float x1, float y1, float x2, float y2, Color color) {
+    commands_.push_back({ Type::Line, 255, color, 0, nullptr, x1, y1, x2, y2 });
+  }
+
+  inline void AddRect(const SDL_Rect& rc, Color color, uint8_t alpha = 255) {
+    AddRectangle(Type::Rect, rc, color, alpha, nullptr, 0);
+  }
+
+  inline void AddFillRect(const SDL_Rect& rc, Color color, uint8_t alpha = 255) {
+    AddRectangle(Type::FillRect, rc, color, alpha, nullptr, 0);
+  }
+
+  // Copies the whole texture to rc
+  inline void AddCopy(SDL_Texture* texture, const SDL_Rect& rc) {
+    AddRectangle(Type::Copy, rc, Color::White, 255, texture, 0);
+  }
+
+  void AddText(const Font& font, int x, int y, std::string_view text, Color color);
+
+  // Reserves rc.w * rc.h pixels to be written to the texture when the buffer is submitted. The
+  // pointer is only valid until the next upload is added.
+  uint32_t* AddUpload(SDL_Texture* texture, const SDL_Rect& rc);
+
+  void Append(const CommandBuffer& other);
+
+  void Clear();
+
+  inline bool IsEmpty() const { return commands_.empty(); }
+
+  // An unchanged buffer draws the same frame as the buffer recorded before it, so the frame on
+  // screen can be kept instead. Cleared with the commands.
+  inline void SetUnchanged(bool unchanged) { unchanged_ = unchanged; }
+
+  inline bool IsUnchanged() const { return unchanged_; }
+
+  inline size_t size() const { return commands_.size(); }
+
+  inline const std::vector<Command>& commands() const { return commands_; }
+
+  inline std::string_view text(const Command& command) const {
+    const auto& text = texts_[command.index];
+
+    return std::string_view(characters_.data() + text.offset, text.size);
+  }
+
+  inline const Font& font(const Command& command) const { return texts_[command.index].font; }
+
+  inline const Upload& upload(const Command& command) const { return uploads_[command.index]; }
+
+  inline const uint32_t* pixels(const Command& command) const {
+    return pixels_.data() + uploads_[command.index].offset;
+  }
+
+ protected:
+  inline void AddRectangle(Type type, const SDL_Rect& rc, Color color, uint8_t alpha, SDL_Texture* texture,
+                           uint32_t index) {
+    commands_.push_back({ type, alpha, color, index, texture, static_cast<float>(rc.x), static_cast<float>(rc.y),
+                          static_cast<float>(rc.w), static_cast<float>(rc.h) });
+  }
+
+ private:
+  std::vector<Command> commands_;
+  std::vector<Text> texts_;
+  std::vector<char> characters_;
+  std::vector<Upload> uploads_;
+  std::vector<uint32_t> pixels_;
+  bool unchanged_ = false;
+};
+
+// Turns command buffers into SDL_Render calls, on the thread owning the renderer. Consecutive
+// lines become one batch and consecutive text one atlas draw, order between kinds is kept.
+class CommandRenderer final {
+ public:
+  CommandRenderer(SDL_Renderer* renderer, const std::shared_ptr<GlyphAtlas>& atlas)
+      : renderer_(renderer), atlas_(atlas) {}
+
+  CommandRenderer(const CommandRenderer&) = delete;
+
+  void Submit(const CommandBuffer& buffer);
+
+ protected:
+  void Flush(CommandBuffer::Type next);
+
+ private:
+  SDL_Renderer* renderer_;
+  std::shared_ptr<GlyphAtlas> atlas_;
+  LineBatch batch_;
+  bool has_text_ = false;
+};
+
+} // namespace utility
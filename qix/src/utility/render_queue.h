@@ -0,0 +1,89 @@
+#pragma once
+
+#include "utility/render_commands.h"
+
+#include <array>
+#include <mutex>
+#include <condition_variable>
+
+namespace utility {
+
+// Double buffered hand off of recorded frames from the thread running the logic to the thread
+// owning the renderer. While one frame is submitted, and the submitting thread waits for vsync,
+// the next frame is recorded into the other buffer.
+class RenderQueue final {
+ public:
+  RenderQueue() = default;
+
+  RenderQueue(const RenderQueue&) = delete;
+
+  ~RenderQueue() noexcept { Cancel(); }
+
+  // Waits for a free buffer and returns it cleared, nullptr once cancelled
+  CommandBuffer* BeginRecord() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    event_.wait(lock, [this] { return State::Free == states_[record_] || cancelled_; });
+    if (cancelled_) {
+      return nullptr;
+    }
+    states_[record_] = State::Recording;
+    buffers_[record_].Clear();
+
+    return &buffers_[record_];
+  }
+
+  // Hands the recorded frame to the submitting thread
+  void EndRecord() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    states_[record_] = State::Ready;
+    record_ ^= 1;
+    lock.unlock();
+    event_.notify_all();
+  }
+
+  // Waits for a recorded frame, nullptr once cancelled
+  const CommandBuffer* BeginSubmit() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    event_.wait(lock, [this] { return State::Ready == states_[submit_] || cancelled_; });
+    if (cancelled_) {
+      return nullptr;
+    }
+    states_[submit_] = State::Submitting;
+
+    return &buffers_[submit_];
+  }
+
+  // Returns the submitted buffer for recording
+  void EndSubmit() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    states_[submit_] = State::Free;
+    submit_ ^= 1;
+    lock.unlock();
+    event_.notify_all();
+  }
+
+  void Cancel() noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    cancelled_ = true;
+    lock.unlock();
+    event_.notify_all();
+  }
+
+ private:
+  enum class State { Free, Recording, Ready, Submitting };
+
+  std::mutex mutex_;
+  std::condition_variable event_;
+  std::array<CommandBuffer, 2> buffers_;
+  std::array<State, 2> states_ = { State::Free, State::Free };
+  size_t record_ = 0;
+  size_t submit_ = 0;
+  bool cancelled_ = false;
+};
+
+} // namespace utility
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace utility {
+
+// Bounded queue for exactly one producer thread and one consumer thread, neither ever blocks
+// or takes a lock. Head and tail live on separate cache lines, and each side keeps a cached
+// copy of the other side's index so it only touches the shared line when it looks full or empty.
+template<typename T, size_t Capacity>
+class SpscQueue final {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+ public:
+  static constexpr size_t kCacheLineSize = 64;
+
+  SpscQueue() = default;
+
+  SpscQueue(const SpscQueue&) = delete;
+
+  // Producer side, returns false if the queue is full
+  bool TryPush(const T& value) { return Emplace(value); }
+
+  bool TryPush(T&& value) { return Emplace(std::move(value)); }
+
+  // Consumer side, returns false if the queue is empty
+  bool TryPop(T& value) {
+    const auto head = head_.load(std::memory_order_relaxed);
+
+    if (head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+    value = std::move(buffer_[head & kMask]);
+    head_.store(head + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  // Consumer side, hands up to max_count values to function and releases their slots with a
+  // single store. Returns the number of values drained.
+  template<typename Function>
+  size_t Drain(Function function, size_t max_count = Capacity) {
+    const auto head = head_.load(std::memory_order_relaxed);
+
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+
+    const auto count = std::min<size_t>(cached_tail_ - head, max_count);
+
+    for (size_t i = 0; i < count; ++i) {
+      function(std::move(buffer_[(head + i) & kMask]));
+    }
+    head_.store(head + count, std::memory_order_release);
+
+    return count;
+  }
+
+  // Only a snapshot when the other side is running
+  inline size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+
+  inline bool empty() const { return 0 == size(); }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+ protected:
+  static constexpr size_t kMask = Capacity - 1;
+
+  template<typename U>
+  bool Emplace(U&& value) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+
+    if (tail - cached_head_ == Capacity) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      if (tail - cached_head_ == Capacity) {
+        return false;
+      }
+    }
+    buffer_[tail & kMask] = std::forward<U>(value);
+    tail_.store(tail + 1, std::memory_order_release);
+
+    return true;
+  }
+
+ private:
+  // Written by the consumer
+  alignas(kCacheLineSize) std::atomic<size_t> head_ = 0;
+  size_t cached_tail_ = 0;
+  // Written by the producer
+  alignas(kCacheLineSize) std::atomic<size_t> tail_ = 0;
+  size_t cached_head_ = 0;
+  alignas(kCacheLineSize) std::array<T, Capacity> buffer_;
+};
+
+} // namespace utility
@@ -15,14 +15,6 @@ std::tuple<UniqueTexturePtr, int, int> CreateTextureFromText(SDL_Renderer* rende
   return std::make_tuple(std::move(texture), width, height);
 }
 
-void RenderText(SDL_Renderer *renderer, int x, int y, TTF_Font* font, const std::string& text, Color text_color) {
-  auto [texture, width, height] = CreateTextureFromText(renderer, font, text, text_color);
-
-  SDL_Rect rc{ x, y, width, height };
-
-  SDL_RenderCopy(renderer, texture.get(), nullptr, &rc);
-}
-
 std::tuple<UniqueTexturePtr, int, int> CreateTextureFromFramedText(SDL_Renderer* renderer, TTF_Font* font,
                                                                const std::string& text, Color text_color,
                                                                Color background_color) {
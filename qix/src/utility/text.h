@@ -13,8 +13,6 @@ namespace utility {
 
 using UniqueTexturePtr = std::unique_ptr<SDL_Texture, function_caller<void(SDL_Texture*), &SDL_DestroyTexture>>;
 
-void RenderText(SDL_Renderer* renderer, int x, int y, TTF_Font* font, const std::string& text, Color text_color);
-
 std::tuple<UniqueTexturePtr, int, int> CreateTextureFromText(SDL_Renderer* renderer, TTF_Font* font,
                                                              const std::string& text, Color text_color);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <atomic>
 #include <queue>
 #include <condition_variable>
@@ -17,7 +18,7 @@ class ThreadSafeQueue {
     std::unique_lock<std::mutex> lock(mutex_);
 
     queue_.push(std::move(new_value));
-    size_ = queue_.size();
+    size_.store(queue_.size(), std::memory_order_release);
     lock.unlock();
     event_.notify_one();
   }
@@ -39,7 +40,7 @@ class ThreadSafeQueue {
     auto value(std::move(queue_.front()));
 
     queue_.pop();
-    size_ = queue_.size();
+    size_.store(queue_.size(), std::memory_order_release);
 
     return value;
   }
@@ -57,14 +58,15 @@ class ThreadSafeQueue {
 
   inline bool is_cancelled() const { return abort_.load(std::memory_order_acquire); }
 
-  inline size_t size() const { return size_; }
+  // Read without the lock, only a snapshot while other threads push or pop
+  inline size_t size() const { return size_.load(std::memory_order_acquire); }
 
-  inline bool empty() const { return 0 == size_; }
+  inline bool empty() const { return 0 == size(); }
 
  private:
   mutable std::mutex mutex_;
   std::condition_variable event_;
   std::queue<T> queue_;
   std::atomic<bool> abort_;
-  size_t size_;
+  std::atomic<size_t> size_;
 };
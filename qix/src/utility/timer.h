@@ -188,4 +188,39 @@ private:
   TimePoint previous_time_;
 };
 
+// Splits real time into logic ticks of fixed length. Left over time is kept for the next
+// frame and exposed as how far, 0 to 1, the renderer is between the last two ticks.
+class FixedTimestep final {
+ public:
+  explicit FixedTimestep(double tick, int max_ticks_per_frame = 8)
+      : tick_(tick), max_ticks_per_frame_(max_ticks_per_frame) {}
+
+  // Returns the number of ticks to run for a frame that took delta seconds. After a long stall
+  // the backlog is dropped rather than running the simulation even further behind.
+  int Advance(double delta) {
+    accumulator_ += delta;
+
+    int ticks = static_cast<int>(accumulator_ / tick_);
+
+    if (ticks > max_ticks_per_frame_) {
+      ticks = max_ticks_per_frame_;
+      accumulator_ = tick_ * ticks;
+    }
+    accumulator_ -= tick_ * ticks;
+
+    return ticks;
+  }
+
+  inline double alpha() const { return accumulator_ / tick_; }
+
+  inline double tick() const { return tick_; }
+
+  void Reset() { accumulator_ = 0.0; }
+
+ private:
+  double tick_;
+  int max_ticks_per_frame_;
+  double accumulator_ = 0.0;
+};
+
 } // namespace utility
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace utility {
+
+// LEB128, seven bits per byte with the high bit set on every byte but the last
+inline void PutVarint(std::vector<uint8_t>& buffer, uint64_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+// Reads one varint at offset and moves offset past it. Returns false, and leaves offset as it
+// was, if the buffer ends in the middle of it or it does not fit in 64 bits.
+inline bool GetVarint(const std::vector<uint8_t>& buffer, size_t& offset, uint64_t& value) {
+  uint64_t result = 0;
+
+  for (size_t i = offset, shift = 0; i < buffer.size() && shift < 64; ++i, shift += 7) {
+    result |= static_cast<uint64_t>(buffer[i] & 0x7f) << shift;
+    if (0 == (buffer[i] & 0x80)) {
+      value = result;
+      offset = i + 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace utility
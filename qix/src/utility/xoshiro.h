@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include <cstdint>
+
+namespace utility {
+
+// xoshiro256** by Blackman and Vigna, the state is seeded through splitmix64 so any seed,
+// zero included, gives a good state. Fast, small and the same sequence on every platform, a
+// seed replays exactly. Usable with the standard distributions, but those are implementation
+// defined, Uniform() is not.
+class Xoshiro256 final {
+ public:
+  using result_type = uint64_t;
+
+  explicit Xoshiro256(uint64_t seed) {
+    for (auto& s : state_) {
+      seed += 0x9e3779b97f4a7c15ull;
+
+      uint64_t z = seed;
+
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      s = z ^ (z >> 31);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  inline result_type operator()() {
+    const uint64_t result = Rotate(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = Rotate(state_[3], 45);
+
+    return result;
+  }
+
+  // Uniform in [min, max), from the top 24 bits
+  inline float Uniform(float min, float max) {
+    return min + (max - min) * static_cast<float>((*this)() >> 40) * (1.0f / 16777216.0f);
+  }
+
+  // Uniform in [min, max], the top 32 bits scaled by a multiply and shift. Biased by at most
+  // the size of the range in 2^32, nothing a game can tell.
+  inline int UniformInt(int min, int max) {
+    const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+
+    return static_cast<int>(min + static_cast<int64_t>((((*this)() >> 32) * range) >> 32));
+  }
+
+ protected:
+  static inline uint64_t Rotate(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+ private:
+  std::array<uint64_t, 4> state_;
+};
+
+} // namespace utility
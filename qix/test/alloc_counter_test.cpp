@@ -0,0 +1,41 @@
+#include "catch.hpp"
+#include "utility/alloc_counter.h"
+
+#include <new>
+#include <memory>
+#include <cstdint>
+
+namespace {
+
+struct alignas(64) Aligned {
+  int value = 0;
+};
+
+}  // namespace
+
+TEST_CASE("Allocation counter sees every form of new", "[alloc]") {
+  if (!utility::kCountAllocations) {
+    return;
+  }
+  const std::align_val_t alignment{ 64 };
+  auto allocations = utility::AllocationCount();
+
+  // Called directly, new expressions paired with a delete may be left out by the compiler
+  ::operator delete(::operator new(8));
+  ::operator delete[](::operator new[](8));
+  ::operator delete(::operator new(8, std::nothrow), std::nothrow);
+  ::operator delete[](::operator new[](8, std::nothrow), std::nothrow);
+  ::operator delete(::operator new(8, alignment), alignment);
+  ::operator delete[](::operator new[](8, alignment), alignment);
+  ::operator delete(::operator new(8, alignment, std::nothrow), alignment, std::nothrow);
+  ::operator delete[](::operator new[](8, alignment, std::nothrow), alignment, std::nothrow);
+  REQUIRE(utility::AllocationCount() - allocations == 8);
+  allocations = utility::AllocationCount();
+
+  auto aligned = std::make_unique<Aligned>();
+  auto aligned_array = std::make_unique<Aligned[]>(3);
+
+  REQUIRE(utility::AllocationCount() - allocations == 2);
+  REQUIRE(0 == reinterpret_cast<uintptr_t>(aligned.get()) % alignof(Aligned));
+  REQUIRE(0 == reinterpret_cast<uintptr_t>(aligned_array.get()) % alignof(Aligned));
+}
@@ -0,0 +1,63 @@
+#include "catch.hpp"
+#include "game/autoplayer.h"
+
+namespace {
+
+const double kLogicTick = 1.0 / kLogicTicksPerSecond;
+
+}  // namespace
+
+TEST_CASE("Autoplayer draws closed boxes", "[autoplayer]") {
+  Playfield playfield(Playfield::Backend::Null);
+  Autoplayer autoplayer(1981);
+  int closed = 0;
+  int deaths = 0;
+  bool was_drawing = false;
+
+  playfield.NewGame();
+  for (int tick = 0; tick < 5000; ++tick) {
+    const auto control = autoplayer.Next(playfield);
+
+    if (Playfield::Controls::None != control) {
+      playfield.GameControl(control);
+    }
+    playfield.Update(kLogicTick);
+    // Back on an edge without being cut, the stix was closed
+    if (was_drawing && !playfield.IsDrawing() && deaths == playfield.deaths()) {
+      const auto pt = playfield.player();
+
+      REQUIRE(Grid::Cell::Edge == playfield.grid().Get(pt.x, pt.y));
+      closed++;
+    }
+    was_drawing = playfield.IsDrawing();
+    deaths = playfield.deaths();
+  }
+  REQUIRE(closed > 1);
+}
+
+TEST_CASE("Autoplayers with the same seed play the same game", "[autoplayer]") {
+  Playfield first(Playfield::Backend::Null);
+  Playfield second(Playfield::Backend::Null);
+  Autoplayer a(7);
+  Autoplayer b(7);
+  Autoplayer c(8);
+  bool differs = false;
+
+  first.NewGame();
+  second.NewGame();
+  for (int tick = 0; tick < 2000; ++tick) {
+    const auto control = a.Next(first);
+
+    REQUIRE(control == b.Next(second));
+    differs = differs || control != c.Next(second);
+    if (Playfield::Controls::None != control) {
+      first.GameControl(control);
+      second.GameControl(control);
+    }
+    first.Update(kLogicTick);
+    second.Update(kLogicTick);
+  }
+  REQUIRE(first.player().x == second.player().x);
+  REQUIRE(first.player().y == second.player().y);
+  REQUIRE(differs);
+}
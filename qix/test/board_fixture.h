@@ -0,0 +1,101 @@
+#pragma once
+
+#include "game/grid.h"
+
+#include <array>
+#include <random>
+#include <vector>
+#include <cstdlib>
+
+// Random boards for the claim tests, boxes drawn out from the edges the way a player closes a stix
+
+const int kBoardWidth = 200;
+const int kBoardHeight = 150;
+
+const std::array<SDL_Point, 4> kSteps = {{ { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } }};
+
+inline bool IsCell(const Grid& grid, int x, int y, Grid::Cell cell) {
+  return grid.IsInside(x, y) && cell == grid.Get(x, y);
+}
+
+inline bool IsNear(SDL_Point a, SDL_Point b) { return std::abs(a.x - b.x) <= 1 && std::abs(a.y - b.y) <= 1; }
+
+// A stix that passes next to an edge or itself leaves a gap without cells between them. The
+// gap splits the unclaimed cells, not the area. Only the path around the stix may touch it.
+inline bool IsClear(const Grid& grid, SDL_Point start, const std::vector<SDL_Point>& stix, SDL_Point end) {
+  for (size_t i = 0; i < stix.size(); ++i) {
+    const auto pt = stix[i];
+
+    for (int y = pt.y - 1; y <= pt.y + 1; ++y) {
+      for (int x = pt.x - 1; x <= pt.x + 1; ++x) {
+        const SDL_Point near = { x, y };
+        const bool touches = IsCell(grid, x, y, Grid::Cell::Edge) || IsCell(grid, x, y, Grid::Cell::Stix);
+        const bool path = (i < 2 && IsNear(near, start)) || (i + 2 >= stix.size() && IsNear(near, end)) ||
+                          (i >= 2 && IsNear(near, stix[i - 2])) || (i + 2 < stix.size() && IsNear(near, stix[i + 2]));
+
+        if (touches && !path && !(near.x == pt.x && near.y == pt.y)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Draws a box out from an edge cell, in, across and back until it meets an edge. Returns false
+// and leaves the grid as it was if the box is blocked, or with clear set, not clear of other edges.
+inline bool DrawBox(Grid& grid, std::mt19937& rng, SDL_Point& start, std::vector<SDL_Point>& stix, SDL_Point& end,
+                    bool clear = false) {
+  const auto out = kSteps[rng() % 4];
+  const SDL_Point in = { -out.x, -out.y };
+  const SDL_Point across = (0 != in.x) ? kSteps[2 + rng() % 2] : kSteps[rng() % 2];
+  const std::array<std::pair<SDL_Point, int>, 3> sides = {{
+    { in, 2 + static_cast<int>(rng() % 40) }, { across, 2 + static_cast<int>(rng() % 60) }, { out, -1 }
+  }};
+  auto undo = [&grid, &stix] {
+    for (const auto& cell : stix) {
+      grid.Set(cell.x, cell.y, Grid::Cell::Unclaimed);
+    }
+    stix.clear();
+    return false;
+  };
+
+  // Out from a random cell to the first edge cell that way
+  start = { static_cast<int>(rng() % grid.width()), static_cast<int>(rng() % grid.height()) };
+  while (grid.IsInside(start.x, start.y) && !IsCell(grid, start.x, start.y, Grid::Cell::Edge)) {
+    start = { start.x + out.x, start.y + out.y };
+  }
+  stix.clear();
+  if (!grid.IsInside(start.x, start.y)) {
+    return false;
+  }
+  SDL_Point pt = start;
+
+  for (const auto& [step, count] : sides) {
+    for (int i = 0; i != count; ++i) {
+      const SDL_Point next = { pt.x + step.x, pt.y + step.y };
+
+      if (IsCell(grid, next.x, next.y, Grid::Cell::Edge) && !stix.empty()) {
+        end = next;
+        return !clear || IsClear(grid, start, stix, end) || undo();
+      }
+      if (!IsCell(grid, next.x, next.y, Grid::Cell::Unclaimed)) {
+        return undo();
+      }
+      pt = next;
+      grid.Set(pt.x, pt.y, Grid::Cell::Stix);
+      stix.push_back(pt);
+    }
+  }
+  return undo();
+}
+
+// A random unclaimed cell for the Qix, 0, 0 if none turned up
+inline SDL_Point PlaceQix(const Grid& grid, std::mt19937& rng) {
+  SDL_Point qix = { 0, 0 };
+
+  for (int tries = 0; tries < 100 && Grid::Cell::Unclaimed != grid.Get(qix.x, qix.y); ++tries) {
+    qix = { static_cast<int>(rng() % grid.width()), static_cast<int>(rng() % grid.height()) };
+  }
+  return qix;
+}
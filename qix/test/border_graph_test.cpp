@@ -0,0 +1,96 @@
+#include "catch.hpp"
+#include "board_fixture.h"
+#include "game/border_graph.h"
+#include "game/flood_fill.h"
+
+namespace {
+
+bool IsEdge(const Grid& grid, int x, int y) { return IsCell(grid, x, y, Grid::Cell::Edge); }
+
+// The graph holds exactly the edge cells of the grid that continue into another edge cell
+bool Matches(const Grid& grid, const BorderGraph& border) {
+  for (int y = 0; y < grid.height(); ++y) {
+    for (int x = 0; x < grid.width(); ++x) {
+      const bool connected = IsEdge(grid, x, y) && (IsEdge(grid, x - 1, y) || IsEdge(grid, x + 1, y) ||
+                                                    IsEdge(grid, x, y - 1) || IsEdge(grid, x, y + 1));
+
+      if (connected != border.IsOnBorder(x, y)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST_CASE("Border graph starts as the border of the grid", "[border_graph]") {
+  BorderGraph border(kBoardWidth, kBoardHeight);
+  BorderGraph::Walker walker;
+
+  REQUIRE(border.nodes() == 4);
+  REQUIRE(border.edges() == 4);
+  REQUIRE(border.length() == 2 * (kBoardWidth - 1) + 2 * (kBoardHeight - 1));
+  REQUIRE(border.IsOnBorder(kBoardWidth / 2, 0));
+  REQUIRE_FALSE(border.IsOnBorder(kBoardWidth / 2, 1));
+  REQUIRE(border.Connects(kBoardWidth / 2, 0, 1, 0));
+  REQUIRE_FALSE(border.Connects(kBoardWidth / 2, 0, 0, 1));
+  REQUIRE(border.Connects(0, 0, 0, 1));
+  REQUIRE_FALSE(border.Connects(0, 0, -1, 0));
+
+  walker.x = kBoardWidth / 2;
+  REQUIRE(border.Walk(walker, kBoardWidth, BorderGraph::Turn::Right));
+  REQUIRE(walker.x == kBoardWidth - 1);
+  REQUIRE(walker.y == kBoardWidth / 2 + 1);
+  REQUIRE(border.Walk(walker, border.length() - kBoardWidth, BorderGraph::Turn::Right));
+  REQUIRE(walker.x == kBoardWidth / 2);
+  REQUIRE(walker.y == 0);
+}
+
+TEST_CASE("Border graph follows the grid through claims", "[border_graph]") {
+  Grid grid(kBoardWidth, kBoardHeight);
+  FloodFill flood_fill(kBoardWidth, kBoardHeight);
+  BorderGraph border(kBoardWidth, kBoardHeight);
+  std::mt19937 rng(1981);
+  std::vector<SDL_Point> stix;
+  SDL_Point start;
+  SDL_Point end;
+  BorderGraph::Walker walker;
+  int claims = 0;
+
+  for (int i = 0; i < 4000; ++i) {
+    // A new game every now and then, the board fills up quickly
+    if (0 == i % 200) {
+      grid.Reset();
+      border.Reset();
+    }
+    if (!DrawBox(grid, rng, start, stix, end)) {
+      continue;
+    }
+    for (const auto& pt : stix) {
+      grid.Set(pt.x, pt.y, Grid::Cell::Edge);
+    }
+    border.AddPath(start, stix, end);
+
+    const auto qix = PlaceQix(grid, rng);
+
+    if (flood_fill.Claim(grid, qix.x, qix.y) > 0) {
+      const auto [y1, y2] = flood_fill.claimed_rows();
+
+      border.Update(grid, y1, y2);
+      claims++;
+    }
+    REQUIRE(Matches(grid, border));
+  }
+  REQUIRE(claims > 100);
+
+  // Walkers stay on the border wherever they are taken
+  for (int i = 0; !border.IsOnBorder(walker.x, walker.y); ++i) {
+    walker.x = i % kBoardWidth;
+    walker.y = i / kBoardWidth;
+  }
+  for (int i = 0; i < 1000; ++i) {
+    REQUIRE(border.Walk(walker, 1 + static_cast<int>(rng() % 50), BorderGraph::Turn::Left));
+    REQUIRE(IsEdge(grid, walker.x, walker.y));
+  }
+}
@@ -0,0 +1,105 @@
+#include "catch.hpp"
+#include "game/claim_tracker.h"
+
+#include <random>
+
+namespace {
+
+const int kWidth = 200;
+const int kHeight = 150;
+
+size_t CountClaimed(const Grid& grid, int y) {
+  size_t count = 0;
+
+  for (int x = 0; x < grid.width(); ++x) {
+    count += (Grid::Cell::Claimed == grid.Get(x, y)) ? 1 : 0;
+  }
+  return count;
+}
+
+size_t CountClaimed(const Grid& grid) {
+  size_t count = 0;
+
+  for (int y = 0; y < grid.height(); ++y) {
+    count += CountClaimed(grid, y);
+  }
+  return count;
+}
+
+// Draws a horizontal or vertical edge starting at the border. Walls that reach across
+// split the unclaimed area in two, shorter ones only make it more fragmented.
+void DrawWall(Grid& grid, std::mt19937& rng) {
+  const bool across = rng() % 2;
+
+  if (rng() % 2) {
+    const int x = 1 + rng() % (grid.width() - 2);
+    const int length = across ? grid.height() - 2 : 1 + rng() % (grid.height() - 2);
+
+    for (int y = 1; y <= length; ++y) {
+      if (Grid::Cell::Unclaimed == grid.Get(x, y)) {
+        grid.Set(x, y, Grid::Cell::Edge);
+      }
+    }
+  } else {
+    const int y = 1 + rng() % (grid.height() - 2);
+    const int length = across ? grid.width() - 2 : 1 + rng() % (grid.width() - 2);
+
+    for (int x = 1; x <= length; ++x) {
+      if (Grid::Cell::Unclaimed == grid.Get(x, y)) {
+        grid.Set(x, y, Grid::Cell::Edge);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Claim tracker matches a brute force recount on random fills", "[claim_tracker]") {
+  std::mt19937 rng(1981);
+  size_t claims = 0;
+
+  for (int game = 0; game < 20; ++game) {
+    Grid grid(kWidth, kHeight);
+    FloodFill flood_fill(kWidth, kHeight);
+    ClaimTracker claim_tracker(kWidth, kHeight);
+
+    for (int claim = 0; claim < 10; ++claim) {
+      DrawWall(grid, rng);
+      if (flood_fill.Claim(grid, rng() % kWidth, rng() % kHeight) > 0) {
+        claim_tracker.Add(flood_fill);
+        claims++;
+      }
+      for (int y = 0; y < kHeight; ++y) {
+        REQUIRE(claim_tracker.claimed(y) == static_cast<int>(CountClaimed(grid, y)));
+      }
+      const auto claimed = CountClaimed(grid);
+
+      REQUIRE(claim_tracker.claimed() == claimed);
+      REQUIRE(claim_tracker.Percentage() == Approx(100.0 * claimed / (kWidth * kHeight)));
+    }
+  }
+  REQUIRE(claims > 0);
+}
+
+TEST_CASE("Claim tracker recount agrees with incremental updates", "[claim_tracker]") {
+  std::mt19937 rng(2021);
+  Grid grid(kWidth, kHeight);
+  FloodFill flood_fill(kWidth, kHeight);
+  ClaimTracker incremental(kWidth, kHeight);
+  ClaimTracker recount(kWidth, kHeight);
+
+  for (int claim = 0; claim < 25; ++claim) {
+    DrawWall(grid, rng);
+    if (flood_fill.Claim(grid, rng() % kWidth, rng() % kHeight) > 0) {
+      incremental.Add(flood_fill);
+    }
+  }
+  recount.Recount(grid);
+  REQUIRE(recount.claimed() == incremental.claimed());
+  for (int y = 0; y < kHeight; ++y) {
+    REQUIRE(recount.claimed(y) == incremental.claimed(y));
+  }
+  incremental.Reset();
+  REQUIRE(0 == incremental.claimed());
+  REQUIRE(0.0 == incremental.Percentage());
+}
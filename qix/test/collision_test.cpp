@@ -0,0 +1,85 @@
+#include "catch.hpp"
+#include "game/collision.h"
+
+#include <random>
+
+namespace {
+
+using Segment = SegmentGrid::Segment;
+
+const int kWidth = 800;
+const int kHeight = 800;
+
+// A stix like trail, unit steps in random directions that stays on the field
+std::vector<Segment> CreateTrail(std::mt19937& rng, int length) {
+  std::vector<Segment> trail;
+  int x = rng() % kWidth;
+  int y = rng() % kHeight;
+  int dx = 1;
+  int dy = 0;
+
+  for (int i = 0; i < length; ++i) {
+    if (0 == rng() % 20) {
+      std::tie(dx, dy) = std::make_pair(dy, dx);
+      if (rng() % 2) {
+        dx = -dx;
+        dy = -dy;
+      }
+    }
+    const int nx = std::clamp(x + dx, 0, kWidth - 1);
+    const int ny = std::clamp(y + dy, 0, kHeight - 1);
+
+    trail.push_back({ static_cast<float>(x), static_cast<float>(y), static_cast<float>(nx), static_cast<float>(ny) });
+    x = nx;
+    y = ny;
+  }
+  return trail;
+}
+
+Segment CreateLine(std::mt19937& rng) {
+  std::uniform_real_distribution<float> position(-50.0f, kWidth + 50.0f);
+  std::uniform_real_distribution<float> offset(-100.0f, 100.0f);
+  const float x = position(rng);
+  const float y = position(rng);
+
+  return { x, y, x + offset(rng), y + offset(rng) };
+}
+
+}  // namespace
+
+TEST_CASE("Segment intersection handles crossing, touching and parallel segments", "[collision]") {
+  REQUIRE(SegmentsIntersect({ 0, 0, 10, 10 }, { 0, 10, 10, 0 }));
+  REQUIRE(SegmentsIntersect({ 0, 0, 10, 0 }, { 10, 0, 10, 10 }));
+  REQUIRE(SegmentsIntersect({ 0, 0, 10, 0 }, { 5, 0, 15, 0 }));
+  REQUIRE(SegmentsIntersect({ 5, 5, 5, 5 }, { 0, 5, 10, 5 }));
+  REQUIRE_FALSE(SegmentsIntersect({ 0, 0, 10, 0 }, { 0, 1, 10, 1 }));
+  REQUIRE_FALSE(SegmentsIntersect({ 0, 0, 10, 0 }, { 11, 0, 20, 0 }));
+  REQUIRE_FALSE(SegmentsIntersect({ 0, 0, 10, 10 }, { 6, 5, 20, 5 }));
+}
+
+TEST_CASE("Segment grid agrees with brute force", "[collision]") {
+  std::mt19937 rng(1981);
+  SegmentGrid grid(kWidth, kHeight, Collision::kCellSize);
+  size_t hits = 0;
+
+  for (int round = 0; round < 10; ++round) {
+    const auto trail = CreateTrail(rng, 5000);
+
+    grid.Clear();
+    for (const auto& s : trail) {
+      grid.Add(s);
+    }
+    REQUIRE(trail.size() == grid.size());
+    for (int i = 0; i < 500; ++i) {
+      const auto line = CreateLine(rng);
+      bool expected = false;
+
+      for (const auto& s : trail) {
+        expected = expected || SegmentsIntersect(s, line);
+      }
+      REQUIRE(grid.Intersects(line) == expected);
+      hits += expected ? 1 : 0;
+    }
+  }
+  REQUIRE(hits > 0);
+}
@@ -0,0 +1,77 @@
+#include "catch.hpp"
+#include "game/objects.h"
+
+namespace {
+
+const int kFieldWidth = 256;
+const int kFieldHeight = 192;
+const double kLogicTick = 1.0 / kLogicTicksPerSecond;
+
+}  // namespace
+
+TEST_CASE("Distance field grows away from the walls", "[distance_field]") {
+  Grid grid(kFieldWidth, kFieldHeight);
+  DistanceField field(kFieldWidth, kFieldHeight);
+  float gx = 0.0f;
+  float gy = 0.0f;
+
+  field.Build(grid);
+  REQUIRE(field.columns() == kFieldWidth / DistanceField::kCellSize);
+  REQUIRE(field.rows() == kFieldHeight / DistanceField::kCellSize);
+  // The border edge blocks the outermost blocks
+  REQUIRE(field.IsBlocked(0, 0));
+  REQUIRE(field.IsBlocked(kFieldWidth - 1, kFieldHeight / 2));
+  REQUIRE(field.at(1, 1) == 3);
+  REQUIRE(field.at(2, 2) == 6);
+  // Closest to the bottom edge
+  REQUIRE(field.at(field.columns() / 2, field.rows() / 2) == 3 * (field.rows() - 1 - field.rows() / 2));
+  REQUIRE(field.Distance(kFieldWidth / 2, kFieldHeight / 2) > field.Distance(kFieldWidth / 2, 20));
+  field.Gradient(kFieldWidth / 2, 12, gx, gy);
+  REQUIRE(gx == Approx(0.0f));
+  REQUIRE(gy == Approx(1.0f));
+
+  // A claimed corner is a wall as well
+  for (int y = 0; y < 64; ++y) {
+    for (int x = 0; x < 64; ++x) {
+      grid.Set(x, y, Grid::Cell::Claimed);
+    }
+  }
+  field.Build(grid);
+  REQUIRE(field.IsBlocked(60, 60));
+  REQUIRE(field.at(8, 8) == 4);
+  field.Gradient(68, 100, gx, gy);
+  REQUIRE(gx > 0.0f);
+}
+
+TEST_CASE("Qix wanders inside the unclaimed area", "[distance_field]") {
+  Grid grid(kFieldWidth, kFieldHeight);
+  DistanceField field(kFieldWidth, kFieldHeight);
+  QixObject first(kFieldWidth / 2, kFieldHeight / 2, 1981);
+  QixObject second(kFieldWidth / 2, kFieldHeight / 2, 1981);
+  SDL_Point low = first.center();
+  SDL_Point high = first.center();
+
+  // Only the right two thirds are left
+  for (int y = 0; y < kFieldHeight; ++y) {
+    for (int x = 0; x < kFieldWidth / 3; ++x) {
+      grid.Set(x, y, Grid::Cell::Claimed);
+    }
+  }
+  field.Build(grid);
+  for (int tick = 0; tick < 60 * kLogicTicksPerSecond; ++tick) {
+    first.Update(kLogicTick, field);
+    second.Update(kLogicTick, field);
+
+    const auto pt = first.center();
+
+    REQUIRE(pt.x == second.center().x);
+    REQUIRE(pt.y == second.center().y);
+    REQUIRE(Grid::Cell::Unclaimed == grid.Get(pt.x, pt.y));
+    low = { std::min(low.x, pt.x), std::min(low.y, pt.y) };
+    high = { std::max(high.x, pt.x), std::max(high.y, pt.y) };
+  }
+  // It gets around
+  REQUIRE(high.x - low.x > kFieldWidth / 3);
+  REQUIRE(high.y - low.y > kFieldHeight / 2);
+  REQUIRE(first.lines().size() == first.lines().capacity());
+}
@@ -0,0 +1,50 @@
+#include "catch.hpp"
+#include "game/entities.h"
+
+TEST_CASE("Entities keep their handles when others are destroyed", "[entities]") {
+  Entities entities(3);
+
+  const auto a = entities.Create(10, 10, 0, 4, 0, utility::Color::Red);
+  const auto b = entities.Create(20, 20, 0, 4, 0, utility::Color::Red);
+  const auto c = entities.Create(30, 30, 0, 4, 0, utility::Color::Red);
+
+  REQUIRE_FALSE(entities.Create(0, 0, 0, 4, 0, utility::Color::Red).is_valid());
+  REQUIRE(entities.Destroy(a));
+  REQUIRE_FALSE(entities.Destroy(a));
+  REQUIRE_FALSE(entities.Contains(a));
+  REQUIRE(entities.size() == 2);
+  REQUIRE(entities.x(b) == 20);
+  REQUIRE(entities.x(c) == 30);
+
+  const auto d = entities.Create(40, 40, 0, 4, 0, utility::Color::Red);
+
+  REQUIRE(entities.Contains(d));
+  REQUIRE_FALSE(entities.Contains(a));
+  entities.Clear();
+  REQUIRE(entities.size() == 0);
+  REQUIRE_FALSE(entities.Contains(b));
+  REQUIRE(entities.Create(0, 0, 0, 4, 0, utility::Color::Red).is_valid());
+}
+
+TEST_CASE("Entities move along their heading and render interpolated", "[entities]") {
+  Entities entities(2);
+  utility::CommandBuffer batch;
+
+  const auto right = entities.Create(0, 0, 0, 10, 100, utility::Color::Red);
+  const auto up = entities.Create(0, 0, 90, 10, 100, utility::Color::Red);
+
+  entities.Update(0.5);
+  REQUIRE(entities.x(right) == Approx(50));
+  REQUIRE(entities.y(right) == Approx(0).margin(1e-4));
+  REQUIRE(entities.x(up) == Approx(0).margin(1e-4));
+  REQUIRE(entities.y(up) == Approx(-50));
+  entities.Render(batch, 0.5f);
+  REQUIRE(batch.size() == 2);
+
+  // Placed outside the update, it renders from its position before the update
+  entities.SetPosition(up, 0, -150);
+  batch.Clear();
+  entities.Render(batch, 0.5f);
+  REQUIRE(entities.y(up) == Approx(-150));
+  REQUIRE((batch.commands()[1].y1 + batch.commands()[1].y2) / 2.0f == Approx(-75));
+}
@@ -0,0 +1,193 @@
+#include "catch.hpp"
+#include "game/events.h"
+
+#include <deque>
+
+namespace {
+
+using Type = Event::Type;
+using QueueRule = Events::QueueRule;
+
+struct Claim {
+  float percentage;
+  int area;
+};
+
+class Counter final : public EventListener {
+ public:
+  virtual void Update(const Event& event) override { types_.push_back(event.type_); }
+
+  std::vector<Type> types_;
+};
+
+// Unsubscribes itself, and subscribes the other listener, when it sees the first event
+class Handover final : public EventListener {
+ public:
+  Handover(Events& events, EventListener& next) : events_(events), next_(next) {}
+
+  virtual void Update(const Event& event) override {
+    types_.push_back(event.type_);
+    events_.Unsubscribe(this);
+    events_.Subscribe(&next_, { Type::NewGame, Type::Pause });
+  }
+
+  Events& events_;
+  EventListener& next_;
+  std::vector<Type> types_;
+};
+
+std::vector<Type> PopAll(Events& events) {
+  std::vector<Type> types;
+
+  while (!events.IsEmpty()) {
+    types.push_back(events.Pop().type_);
+  }
+  return types;
+}
+
+}  // namespace
+
+TEST_CASE("Events keep their order and payload", "[events]") {
+  Events events;
+
+  events.Push(Type::NewGame);
+  events.Push(Type::AreaClaimed, Claim{ 12.5f, 400 });
+  events.PushFront(Type::Pause);
+  REQUIRE(events.size() == 3);
+  REQUIRE(events.Pop().type_ == Type::Pause);
+  REQUIRE(events.Pop().type_ == Type::NewGame);
+
+  const auto event = events.Pop();
+
+  REQUIRE(event.type_ == Type::AreaClaimed);
+  REQUIRE(event.payload<Claim>().percentage == 12.5f);
+  REQUIRE(event.payload<Claim>().area == 400);
+  REQUIRE(events.IsEmpty());
+  REQUIRE(events.Pop().type_ == Type::None);
+}
+
+TEST_CASE("Events without duplicates keep only the newest", "[events]") {
+  Events events;
+
+  events.Push(Type::StixCut);
+  events.Push(Type::NewGame);
+  events.Push(Type::StixCut);
+  REQUIRE(events.Contains(Type::StixCut));
+  events.Push(Type::StixCut, QueueRule::NoDuplicates);
+  REQUIRE(events.size() == 2);
+  REQUIRE(PopAll(events) == std::vector<Type>{ Type::NewGame, Type::StixCut });
+  REQUIRE_FALSE(events.Contains(Type::StixCut));
+  events.Push(Type::Pause);
+  events.Remove(Type::Pause);
+  events.PushFront(Type::Pause);
+  REQUIRE(PopAll(events) == std::vector<Type>{ Type::Pause });
+}
+
+TEST_CASE("Events reuse the slots of removed events", "[events]") {
+  Events events;
+
+  for (size_t i = 0; i < Events::kCapacity; ++i) {
+    REQUIRE(events.Push((i % 2) ? Type::NewGame : Type::StixCut));
+  }
+  REQUIRE_FALSE(events.Push(Type::Pause));
+  events.Remove(Type::NewGame);
+  for (size_t i = 0; i < Events::kCapacity / 2; ++i) {
+    REQUIRE(events.Push(Type::Pause));
+  }
+  REQUIRE(events.size() == Events::kCapacity);
+
+  const auto types = PopAll(events);
+
+  REQUIRE(std::count(types.begin(), types.end(), Type::StixCut) == Events::kCapacity / 2);
+  REQUIRE(types.back() == Type::Pause);
+}
+
+TEST_CASE("Events are only dispatched to subscribers of their type", "[events]") {
+  Events events;
+  Counter game;
+  Counter claims;
+
+  events.Subscribe(&game, { Type::NewGame, Type::Pause });
+  events.Subscribe(&claims, { Type::AreaClaimed });
+  events.Push(Type::NewGame);
+  events.Push(Type::AreaClaimed, Claim{ 1.0f, 1 });
+  events.Push(Type::StixCut);
+  events.Dispatch();
+  REQUIRE(game.types_ == std::vector<Type>{ Type::NewGame });
+  REQUIRE(claims.types_ == std::vector<Type>{ Type::AreaClaimed });
+  events.Unsubscribe(&game);
+  events.Push(Type::Pause);
+  events.Dispatch();
+  REQUIRE(game.types_.size() == 1);
+}
+
+TEST_CASE("Listeners may subscribe and unsubscribe while events are dispatched", "[events]") {
+  Events events;
+  Counter before;
+  Counter after;
+  Counter next;
+  Handover handover(events, next);
+
+  events.Subscribe(&before, { Type::NewGame, Type::Pause });
+  events.Subscribe(&handover, { Type::NewGame, Type::Pause });
+  events.Subscribe(&after, { Type::NewGame, Type::Pause });
+  events.Push(Type::NewGame);
+  events.Push(Type::Pause);
+  events.Dispatch();
+  REQUIRE(handover.types_ == std::vector<Type>{ Type::NewGame });
+  // No listener is skipped when another one leaves, one joining gets the next event
+  REQUIRE(before.types_ == std::vector<Type>{ Type::NewGame, Type::Pause });
+  REQUIRE(after.types_ == std::vector<Type>{ Type::NewGame, Type::Pause });
+  REQUIRE(next.types_ == std::vector<Type>{ Type::Pause });
+  events.Unsubscribe(&before);
+  events.Push(Type::Pause);
+  events.Dispatch();
+  REQUIRE(before.types_.size() == 2);
+  REQUIRE(after.types_.size() == 3);
+}
+
+TEST_CASE("Event throughput", "[events][!benchmark]") {
+  const Type kTypes[] = { Type::NewGame, Type::Pause, Type::AreaClaimed, Type::StixCut };
+  const int kEvents = 128;
+  Events events;
+  Counter counter;
+
+  counter.types_.reserve(kEvents);
+  events.Subscribe(&counter, { Type::AreaClaimed });
+
+  BENCHMARK("Events push and pop") {
+    for (int i = 0; i < kEvents; ++i) {
+      events.Push(kTypes[i & 3]);
+    }
+    return PopAll(events).size();
+  };
+
+  BENCHMARK("Events push without duplicates") {
+    for (int i = 0; i < kEvents; ++i) {
+      events.Push(kTypes[i & 3], QueueRule::NoDuplicates);
+    }
+    const auto size = events.size();
+
+    events.Clear();
+    return size;
+  };
+
+  BENCHMARK("std::deque push without duplicates") {
+    std::deque<Type> queue;
+
+    for (int i = 0; i < kEvents; ++i) {
+      queue.erase(std::remove(queue.begin(), queue.end(), kTypes[i & 3]), queue.end());
+      queue.push_back(kTypes[i & 3]);
+    }
+    return queue.size();
+  };
+
+  BENCHMARK("Events dispatch") {
+    for (int i = 0; i < kEvents; ++i) {
+      events.Push(kTypes[i & 3], Claim{ 1.0f, i });
+    }
+    events.Dispatch();
+    counter.types_.clear();
+    return events.size();
+  };
+}
@@ -0,0 +1,21 @@
+#include "catch.hpp"
+#include "utility/timer.h"
+
+TEST_CASE("Fixed timestep carries left over time to the next frame", "[timestep]") {
+  utility::FixedTimestep timestep(0.01);
+
+  REQUIRE(0 == timestep.Advance(0.005));
+  REQUIRE(timestep.alpha() == Approx(0.5));
+  REQUIRE(1 == timestep.Advance(0.007));
+  REQUIRE(timestep.alpha() == Approx(0.2));
+  REQUIRE(3 == timestep.Advance(0.03));
+  REQUIRE(timestep.alpha() == Approx(0.2));
+}
+
+TEST_CASE("Fixed timestep drops the backlog after a stall", "[timestep]") {
+  utility::FixedTimestep timestep(0.01, 4);
+
+  REQUIRE(4 == timestep.Advance(1.0));
+  REQUIRE(timestep.alpha() == Approx(0.0));
+  REQUIRE(1 == timestep.Advance(0.01));
+}
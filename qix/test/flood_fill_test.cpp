@@ -0,0 +1,128 @@
+#include "catch.hpp"
+#include "game/flood_fill.h"
+
+#include <deque>
+#include <cstring>
+#include <random>
+
+namespace {
+
+// Not a multiple of the 64 cells in a chunk, so the last chunk of a row is partial
+const int kWidth = 150;
+const int kHeight = 90;
+
+bool HasUnclaimedAround(const Grid& grid, int x, int y) {
+  for (int ny = y - 1; ny <= y + 1; ++ny) {
+    for (int nx = x - 1; nx <= x + 1; ++nx) {
+      if (grid.IsInside(nx, ny) && Grid::Cell::Unclaimed == grid.Get(nx, ny)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Random edges, claimed cells and a few stix cells inside the border. Edges without an
+// unclaimed cell around them are claimed, as an earlier claim would have left them.
+Grid CreateBoard(std::mt19937& rng, int density) {
+  Grid grid(kWidth, kHeight);
+
+  for (int y = 1; y < kHeight - 1; ++y) {
+    for (int x = 1; x < kWidth - 1; ++x) {
+      const int roll = static_cast<int>(rng() % 100);
+
+      if (roll < density) {
+        grid.Set(x, y, Grid::Cell::Edge);
+      } else if (roll < density + density / 4) {
+        grid.Set(x, y, Grid::Cell::Claimed);
+      } else if (roll == density + density / 4) {
+        grid.Set(x, y, Grid::Cell::Stix);
+      }
+    }
+  }
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      if (Grid::Cell::Edge == grid.Get(x, y) && !HasUnclaimedAround(grid, x, y)) {
+        grid.Set(x, y, Grid::Cell::Claimed);
+      }
+    }
+  }
+  return grid;
+}
+
+// Every unclaimed cell 4-connected to x, y, one cell at a time
+std::vector<bool> Reachable(const Grid& grid, int x, int y) {
+  std::vector<bool> reachable(static_cast<size_t>(kWidth) * kHeight, false);
+  std::deque<SDL_Point> queue = { { x, y } };
+
+  reachable[static_cast<size_t>(y) * kWidth + x] = true;
+  while (!queue.empty()) {
+    const auto pt = queue.front();
+
+    queue.pop_front();
+    for (const auto& [dx, dy] : { std::pair{ -1, 0 }, std::pair{ 1, 0 }, std::pair{ 0, -1 }, std::pair{ 0, 1 } }) {
+      const int nx = pt.x + dx;
+      const int ny = pt.y + dy;
+
+      if (grid.IsInside(nx, ny) && Grid::Cell::Unclaimed == grid.Get(nx, ny) &&
+          !reachable[static_cast<size_t>(ny) * kWidth + nx]) {
+        reachable[static_cast<size_t>(ny) * kWidth + nx] = true;
+        queue.push_back({ nx, ny });
+      }
+    }
+  }
+  return reachable;
+}
+
+}  // namespace
+
+TEST_CASE("Flood fill matches a brute force fill on random boards", "[flood_fill]") {
+  std::mt19937 rng(1981);
+  FloodFill flood_fill(kWidth, kHeight);
+  int claims = 0;
+
+  for (int i = 0; i < 200; ++i) {
+    const auto board = CreateBoard(rng, 5 + static_cast<int>(rng() % 40));
+    auto grid = board;
+    const SDL_Point qix = { static_cast<int>(rng() % kWidth), static_cast<int>(rng() % kHeight) };
+
+    if (Grid::Cell::Unclaimed != board.Get(qix.x, qix.y)) {
+      REQUIRE(0 == flood_fill.Claim(grid, qix.x, qix.y));
+      REQUIRE(0 == std::memcmp(board.row(0), grid.row(0), sizeof(uint64_t) * board.words_per_row() * kHeight));
+      continue;
+    }
+    const auto reachable = Reachable(board, qix.x, qix.y);
+    const auto claimed = flood_fill.Claim(grid, qix.x, qix.y);
+    size_t expected_claimed = 0;
+    int mismatches = 0;
+
+    // Unclaimed cells away from the Qix are claimed, then edges left without unclaimed cells around them
+    auto expected = board;
+
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        if (Grid::Cell::Unclaimed == board.Get(x, y) && !reachable[static_cast<size_t>(y) * kWidth + x]) {
+          expected.Set(x, y, Grid::Cell::Claimed);
+          expected_claimed++;
+        }
+      }
+    }
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        if (Grid::Cell::Edge == board.Get(x, y) && !HasUnclaimedAround(expected, x, y)) {
+          expected.Set(x, y, Grid::Cell::Claimed);
+          expected_claimed++;
+        }
+      }
+    }
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        mismatches += (expected.Get(x, y) != grid.Get(x, y)) ? 1 : 0;
+      }
+    }
+    REQUIRE(0 == mismatches);
+    REQUIRE(claimed == expected_claimed);
+    claims += (claimed > 0) ? 1 : 0;
+  }
+  REQUIRE(claims > 50);
+}
@@ -0,0 +1,42 @@
+#include "catch.hpp"
+#include "utility/fonts.h"
+
+#include <set>
+
+using namespace utility;
+
+namespace {
+
+const std::vector<Font> kFonts = {
+  Font(Font::Typeface::Cabin, Font::Emphasis::Normal, 14), Font(Font::Typeface::Cabin, Font::Emphasis::Bold, 14),
+  Font(Font::Typeface::Cabin, Font::Emphasis::Normal, 28), Font(Font::Typeface::ObelixPro, Font::Emphasis::Normal, 18),
+  Font(Font::Typeface::ObelixPro, Font::Emphasis::Normal, 20)
+};
+
+}  // namespace
+
+TEST_CASE("Font keys are unique", "[fonts]") {
+  std::set<uint32_t> keys;
+
+  for (const auto& font : kFonts) {
+    REQUIRE(keys.insert(font.key()).second);
+  }
+  REQUIRE(Font(Font::Typeface::Cabin, Font::Emphasis::Normal, 14) == kFonts.front());
+  REQUIRE_FALSE(Font(Font::Typeface::Cabin, Font::Emphasis::Normal, 15) == kFonts.front());
+}
+
+TEST_CASE("Font lookup cost", "[fonts][!benchmark]") {
+  // TTF is never initialized here, every font is cached as a null font and only the lookup is measured
+  Fonts fonts;
+
+  fonts.Preload(kFonts);
+
+  BENCHMARK("Fonts::Get") {
+    uintptr_t sum = 0;
+
+    for (const auto& font : kFonts) {
+      sum += reinterpret_cast<uintptr_t>(fonts.Get(font));
+    }
+    return sum;
+  };
+}
@@ -0,0 +1,41 @@
+#include "catch.hpp"
+#include "game/grid.h"
+
+namespace {
+
+// Not a multiple of the tile size, the last tiles are clipped
+const int kWidth = 200;
+const int kHeight = 150;
+
+}  // namespace
+
+TEST_CASE("Grid tracks changed tiles", "[grid]") {
+  Grid grid(kWidth, kHeight);
+  std::vector<SDL_Rect> spans;
+  const auto collect = [&spans](const SDL_Rect& rc) { spans.push_back(rc); };
+
+  grid.ForEachDirtySpan(collect);
+  // Every tile row is a single span clipped to the grid
+  REQUIRE((kHeight + Grid::kTileSize - 1) / Grid::kTileSize == static_cast<int>(spans.size()));
+  REQUIRE(kWidth == spans.front().w);
+  REQUIRE(kHeight - spans.back().y == spans.back().h);
+
+  grid.ClearDirty();
+  REQUIRE_FALSE(grid.IsDirty());
+  REQUIRE(0 == grid.dirty_tiles());
+
+  grid.Set(Grid::kTileSize + 1, 1, Grid::Cell::Stix);
+  grid.Set(Grid::kTileSize * 2, 2, Grid::Cell::Stix);
+  grid.Set(Grid::kTileSize * 5, Grid::kTileSize * 3, Grid::Cell::Stix);
+  REQUIRE(3 == grid.dirty_tiles());
+
+  spans.clear();
+  grid.ForEachDirtySpan(collect);
+  REQUIRE(2 == spans.size());
+  REQUIRE(Grid::kTileSize == spans[0].x);
+  REQUIRE(0 == spans[0].y);
+  REQUIRE(2 * Grid::kTileSize == spans[0].w);
+  REQUIRE(5 * Grid::kTileSize == spans[1].x);
+  REQUIRE(3 * Grid::kTileSize == spans[1].y);
+  REQUIRE(Grid::kTileSize == spans[1].h);
+}
@@ -0,0 +1,59 @@
+#include "catch.hpp"
+#include "game/input.h"
+
+#include <vector>
+
+namespace {
+
+using Controls = Input::Controls;
+
+std::vector<Controls> Process(Input& input, double time) {
+  std::vector<Controls> applied;
+
+  input.Process(time, [&applied](Controls control) { applied.push_back(control); });
+
+  return applied;
+}
+
+}  // namespace
+
+TEST_CASE("Input applies a press at the first tick after it happened", "[input]") {
+  Input input;
+
+  input.Push(Controls::Left, true, 1.004);
+  REQUIRE(Process(input, 1.0).empty());
+  REQUIRE(Process(input, 1.004) == std::vector<Controls>{ Controls::Left });
+  REQUIRE(Process(input, 1.1).empty());
+}
+
+TEST_CASE("Input auto repeats from the time of the press", "[input]") {
+  Input input;
+
+  input.Push(Controls::Up, true, 2.0);
+  REQUIRE(Process(input, 2.0).size() == 1);
+  REQUIRE(Process(input, 2.299).empty());
+  REQUIRE(Process(input, 2.3).size() == 1);
+  // A late tick catches up on every repeat that was due
+  REQUIRE(Process(input, 2.451) == std::vector<Controls>(3, Controls::Up));
+  input.Push(Controls::Up, false, 2.46);
+  REQUIRE(Process(input, 3.0).empty());
+}
+
+TEST_CASE("Input stops the auto repeat on another control", "[input]") {
+  Input input;
+
+  input.Push(Controls::Right, true, 0.0);
+  input.Push(Controls::Fast, true, 0.32);
+  input.Push(Controls::Right, false, 0.4);
+  REQUIRE(Process(input, 1.0) == std::vector<Controls>{ Controls::Right, Controls::Right, Controls::Fast });
+}
+
+TEST_CASE("Input ignores the release of a control that is not repeating", "[input]") {
+  Input input;
+
+  input.Push(Controls::Down, true, 0.0);
+  input.Push(Controls::Left, false, 0.1);
+  REQUIRE(Process(input, 0.3) == std::vector<Controls>(2, Controls::Down));
+  input.Reset();
+  REQUIRE(Process(input, 1.0).empty());
+}
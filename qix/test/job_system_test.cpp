@@ -0,0 +1,101 @@
+#include "catch.hpp"
+#include "utility/job_system.h"
+
+using namespace utility;
+
+TEST_CASE("Work stealing deque pops in LIFO and steals in FIFO order", "[job_system]") {
+  WorkStealingDeque deque;
+  Job jobs[3];
+
+  REQUIRE(deque.IsEmpty());
+  REQUIRE(nullptr == deque.Pop());
+  REQUIRE(nullptr == deque.Steal());
+  for (auto& job : jobs) {
+    REQUIRE(deque.Push(&job));
+  }
+  REQUIRE(&jobs[2] == deque.Pop());
+  REQUIRE(&jobs[0] == deque.Steal());
+  REQUIRE(&jobs[1] == deque.Pop());
+  REQUIRE(deque.IsEmpty());
+}
+
+TEST_CASE("Parallel for visits every index once", "[job_system]") {
+  for (size_t workers = 1; workers <= 4; ++workers) {
+    JobSystem jobs(workers, false);
+    std::vector<std::atomic<int>> visits(10000);
+    auto visit = [&visits](size_t first, size_t last) {
+      for (auto i = first; i < last; ++i) {
+        visits[i]++;
+      }
+    };
+
+    REQUIRE(workers == jobs.size());
+    for (int pass = 0; pass < 10; ++pass) {
+      jobs.ParallelFor(0, visits.size(), 16, visit);
+    }
+    for (const auto& count : visits) {
+      REQUIRE(10 == count);
+    }
+  }
+}
+
+TEST_CASE("Task groups wait for forked jobs", "[job_system]") {
+  JobSystem jobs(3, false);
+  JobSystem::TaskGroup outer;
+  std::atomic<int> count = 0;
+  // Every outer job forks inner jobs of a group of its own
+  auto inner = [&count] { count++; };
+  auto fork = [&jobs, &inner] {
+    JobSystem::TaskGroup group;
+
+    for (int i = 0; i < 10; ++i) {
+      jobs.Run(group, inner);
+    }
+    jobs.Wait(group);
+  };
+
+  for (int i = 0; i < 100; ++i) {
+    jobs.Run(outer, fork);
+  }
+  jobs.Wait(outer);
+  REQUIRE(outer.IsDone());
+  REQUIRE(1000 == count);
+}
+
+TEST_CASE("Job slots are not reused while a stolen job runs", "[job_system]") {
+  JobSystem jobs(2, false);
+  JobSystem::TaskGroup blocked;
+  JobSystem::TaskGroup rest;
+  std::atomic<bool> started = false;
+  std::atomic<bool> release = false;
+  std::atomic<size_t> count = 0;
+  auto blocker = [&started, &release] {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  };
+  auto inner = [&count] { count++; };
+
+  // The other worker steals the blocker and holds on to its slot while every slot comes round again
+  jobs.Run(blocked, blocker);
+  while (!started) {
+    std::this_thread::yield();
+  }
+  for (size_t i = 0; i < 2 * JobSystem::kMaxJobs; ++i) {
+    jobs.Run(rest, inner);
+  }
+  jobs.Wait(rest);
+  REQUIRE(2 * JobSystem::kMaxJobs == count);
+  REQUIRE_FALSE(blocked.IsDone());
+  release = true;
+  jobs.Wait(blocked);
+  REQUIRE(rest.IsDone());
+}
+
+TEST_CASE("Physical cores are found", "[job_system]") {
+  const auto cores = JobSystem::PhysicalCores();
+
+  REQUIRE_FALSE(cores.empty());
+  REQUIRE(cores.size() <= std::max(std::thread::hardware_concurrency(), 1u));
+}
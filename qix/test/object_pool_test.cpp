@@ -0,0 +1,50 @@
+#include "catch.hpp"
+#include "utility/object_pool.h"
+
+using namespace utility;
+
+namespace {
+
+struct Counted {
+  explicit Counted(int& live, int value) : live_(live), value_(value) { live_++; }
+
+  ~Counted() { live_--; }
+
+  int& live_;
+  int value_;
+};
+
+}  // namespace
+
+TEST_CASE("Object pool hands out slots from its free list", "[pool]") {
+  int live = 0;
+  ObjectPool<Counted> pool(2);
+
+  const auto a = pool.Create(live, 1);
+  const auto b = pool.Create(live, 2);
+
+  REQUIRE(live == 2);
+  REQUIRE(pool.size() == 2);
+  REQUIRE_FALSE(pool.Create(live, 3).is_valid());
+  REQUIRE(pool.Get(a)->value_ == 1);
+  REQUIRE(pool.Get(b)->value_ == 2);
+  REQUIRE(pool.Destroy(a));
+  REQUIRE_FALSE(pool.Destroy(a));
+  REQUIRE(live == 1);
+
+  const auto c = pool.Create(live, 3);
+
+  // The slot is reused, the stale handle is not
+  REQUIRE(c.index == a.index);
+  REQUIRE(nullptr == pool.Get(a));
+  REQUIRE(pool.Get(c)->value_ == 3);
+
+  int sum = 0;
+
+  pool.ForEach([&sum](Counted& counted) { sum += counted.value_; });
+  REQUIRE(sum == 5);
+  pool.Reset();
+  REQUIRE(live == 0);
+  REQUIRE(pool.size() == 0);
+  REQUIRE(nullptr == pool.Get(b));
+}
@@ -0,0 +1,143 @@
+#include "catch.hpp"
+#include "game/playfield.h"
+#include "utility/alloc_counter.h"
+#include "utility/timer.h"
+
+namespace {
+
+// Draws a box out from the player and runs a few ticks along the border after it, every tick is
+// rendered as well when render is set
+void DrawBox(Playfield& playfield, int width, int height, bool render = false) {
+  const std::pair<Playfield::Controls, int> kSides[] = {
+    { Playfield::Controls::Up, height }, { Playfield::Controls::Left, width }, { Playfield::Controls::Down, height },
+    { Playfield::Controls::Left, 10 }
+  };
+  for (const auto& [control, steps] : kSides) {
+    for (int i = 0; i < steps; ++i) {
+      playfield.GameControl(control);
+      playfield.Update(1.0 / kLogicTicksPerSecond);
+      if (render) {
+        playfield.Render(1.0);
+      }
+    }
+  }
+}
+
+// Where the lines of the Qix are a second into a game
+std::vector<float> QixPosition(Playfield& playfield) {
+  utility::CommandBuffer commands;
+  std::vector<float> lines;
+
+  for (int i = 0; i < kLogicTicksPerSecond; ++i) {
+    playfield.Update(1.0 / kLogicTicksPerSecond);
+  }
+  playfield.Record(1.0, commands);
+  for (const auto& command : commands.commands()) {
+    if (utility::CommandBuffer::Type::Line == command.type && utility::Color::Yellow != command.color) {
+      lines.insert(lines.end(), { command.x1, command.y1, command.x2, command.y2 });
+    }
+  }
+  return lines;
+}
+
+}  // namespace
+
+TEST_CASE("Playfield ignores controls while paused", "[playfield]") {
+  Playfield playfield(Playfield::Backend::Null);
+
+  playfield.NewGame();
+  playfield.Pause();
+  REQUIRE(playfield.IsPaused());
+  DrawBox(playfield, 40, 40);
+  REQUIRE(playfield.ClaimedPercentage() == 0.0);
+  playfield.Pause();
+  DrawBox(playfield, 40, 40);
+  REQUIRE(playfield.ClaimedPercentage() > 0.0);
+}
+
+TEST_CASE("Playfield draws the Sparx as entities on the border", "[playfield]") {
+  Playfield playfield(Playfield::Backend::Software);
+  utility::CommandBuffer commands;
+
+  playfield.NewGame();
+  for (int i = 0; i < kLogicTicksPerSecond; ++i) {
+    playfield.Update(1.0 / kLogicTicksPerSecond);
+  }
+  playfield.Record(1.0, commands);
+
+  int lines = 0;
+
+  for (const auto& command : commands.commands()) {
+    if (utility::CommandBuffer::Type::Line != command.type || utility::Color::Yellow != command.color) {
+      continue;
+    }
+    const int x = static_cast<int>(std::lround((command.x1 + command.x2) / 2.0f));
+    const int y = static_cast<int>(std::lround((command.y1 + command.y2) / 2.0f));
+
+    REQUIRE(playfield.border().IsOnBorder(x, y));
+    lines++;
+  }
+  // Two Sparx of two lines each
+  REQUIRE(4 == lines);
+}
+
+TEST_CASE("Playfield seeds every game with the seed after the last", "[playfield]") {
+  Playfield first(Playfield::Backend::Software);
+  Playfield second(Playfield::Backend::Software);
+
+  first.SetSeed(7);
+  first.NewGame();
+
+  const auto seven = QixPosition(first);
+
+  first.NewGame();
+  second.SetSeed(8);
+  second.NewGame();
+
+  const auto eight = QixPosition(second);
+
+  REQUIRE(!seven.empty());
+  REQUIRE(eight == QixPosition(first));
+  REQUIRE(seven != eight);
+}
+
+TEST_CASE("Playfield logic ticks do not allocate once warmed up", "[playfield]") {
+  if (!utility::kCountAllocations) {
+    return;
+  }
+  Playfield playfield(Playfield::Backend::Null);
+
+  playfield.NewGame();
+  DrawBox(playfield, 40, 40);
+
+  const auto allocations = utility::AllocationCount();
+
+  for (int i = 0; i < 3; ++i) {
+    DrawBox(playfield, 40, 40);
+  }
+  REQUIRE(utility::AllocationCount() == allocations);
+}
+
+TEST_CASE("Playfield frames do not allocate once warmed up", "[playfield]") {
+  // The HUD formats its text a few times per second, frames run long enough to see that more than once
+  const int64_t kRunTime = 600; // milliseconds
+
+  if (!utility::kCountAllocations) {
+    return;
+  }
+  Playfield playfield(Playfield::Backend::Software);
+
+  playfield.NewGame();
+  playfield.GameControl(Playfield::Controls::ToggleHud);
+  DrawBox(playfield, 40, 40, true);
+
+  const auto allocations = utility::AllocationCount();
+  const auto start = utility::time_in_ms();
+
+  DrawBox(playfield, 40, 40, true);
+  while (utility::time_in_ms() - start < kRunTime) {
+    playfield.Update(1.0 / kLogicTicksPerSecond);
+    playfield.Render(0.5);
+  }
+  REQUIRE(utility::AllocationCount() == allocations);
+}
@@ -0,0 +1,39 @@
+#include "catch.hpp"
+#include "utility/profiler.h"
+
+using namespace utility;
+
+TEST_CASE("Timing ring keeps the most recent samples", "[profiler]") {
+  TimingRing ring;
+  std::vector<float> samples;
+
+  ring.Snapshot(samples);
+  REQUIRE(samples.empty());
+
+  for (size_t i = 0; i < TimingRing::kCapacity + 10; ++i) {
+    ring.Record(static_cast<float>(i));
+  }
+  ring.Snapshot(samples);
+  REQUIRE(TimingRing::kCapacity == samples.size());
+  REQUIRE(10.0f == samples.front());
+  REQUIRE(static_cast<float>(TimingRing::kCapacity + 9) == samples.back());
+}
+
+TEST_CASE("Profiler reports percentiles in milliseconds", "[profiler]") {
+  Profiler profiler;
+
+  for (int i = 1; i <= 100; ++i) {
+    profiler.Record(Profiler::Phase::Update, i / 1000.0);
+  }
+  const auto stats = profiler.GetStats(Profiler::Phase::Update);
+
+  REQUIRE(stats.p50 == Approx(50.0f).margin(1.0f));
+  REQUIRE(stats.p99 == Approx(99.0f).margin(1.0f));
+  REQUIRE(stats.max == Approx(100.0f));
+  REQUIRE(0.0f == profiler.GetStats(Profiler::Phase::Render).max);
+
+  std::vector<float> scratch;
+
+  REQUIRE(profiler.GetStats(Profiler::Phase::Update, scratch).p99 == stats.p99);
+  REQUIRE(100 == scratch.size());
+}
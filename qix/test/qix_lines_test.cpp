@@ -0,0 +1,65 @@
+#include "catch.hpp"
+#include "game/qix_lines.h"
+
+TEST_CASE("Qix lines move along their heading", "[qix_lines]") {
+  QixLines lines(4);
+
+  lines.Add(100, 100, 0, 10, 10, utility::Color::Red);
+  lines.Add(100, 100, 90, 10, 20, utility::Color::Blue);
+  lines.Update(0.5);
+
+  REQUIRE(lines.x(0) == Approx(105.0f));
+  REQUIRE(lines.y(0) == Approx(100.0f));
+  REQUIRE(lines.x(1) == Approx(100.0f).margin(1e-4));
+  REQUIRE(lines.y(1) == Approx(90.0f));
+
+  utility::CommandBuffer batch;
+
+  lines.Render(batch);
+  REQUIRE(2 == batch.size());
+}
+
+TEST_CASE("Qix lines advance as a ring buffer", "[qix_lines]") {
+  QixLines lines(3);
+
+  lines.Add(10, 10, 0, 10, 0, utility::Color::Red);
+  lines.Advance();
+  lines.Advance();
+  REQUIRE(3 == lines.size());
+
+  lines.Add(20, 30, 0, 10, 0, utility::Color::Red);
+  REQUIRE(3 == lines.size());
+  REQUIRE(lines.x(0) == Approx(10.0f));
+  REQUIRE(lines.x(2) == Approx(20.0f));
+
+  lines.Advance();
+  REQUIRE(lines.x(0) == Approx(10.0f));
+  REQUIRE(lines.x(1) == Approx(20.0f));
+  REQUIRE(lines.x(2) == Approx(20.0f));
+  REQUIRE(lines.y(2) == Approx(30.0f));
+  REQUIRE(lines.center().x == 16);
+}
+
+TEST_CASE("Qix lines render between the last two updates", "[qix_lines]") {
+  QixLines lines(1);
+
+  lines.Add(100, 100, 0, 10, 100, utility::Color::Red);
+  lines.Update(0.1);
+  REQUIRE(lines.x(0) == Approx(110.0f));
+
+  utility::CommandBuffer batch;
+
+  lines.Render(batch, 0.0f);
+  lines.Render(batch, 0.5f);
+  REQUIRE(2 == batch.size());
+
+  const auto& before = batch.commands()[0];
+  const auto& halfway = batch.commands()[1];
+
+  // Heading right, the line stands upright around its center
+  REQUIRE((before.x1 + before.x2) / 2.0f == Approx(100.0f));
+  REQUIRE((before.y1 + before.y2) / 2.0f == Approx(100.0f));
+  REQUIRE(std::abs(before.y1 - before.y2) == Approx(10.0f));
+  REQUIRE((halfway.x1 + halfway.x2) / 2.0f == Approx(105.0f));
+  REQUIRE((halfway.y1 + halfway.y2) / 2.0f == Approx(100.0f));
+}
@@ -0,0 +1,81 @@
+#include "catch.hpp"
+#include "game/grid.h"
+#include "utility/rasterizer.h"
+
+#include <random>
+
+using namespace utility;
+
+namespace {
+
+const int kWidth = 200;
+const int kHeight = 150;
+
+const std::array<Rasterizer::Pattern, 4> kPatterns = {{
+  { 0x000000ff },
+  { 0x0000f0ff, 0xb6c3c9ff, 8 },
+  { 0xffffffff },
+  { 0xf00000ff, 0xf0f000ff, 3 }
+}};
+
+uint32_t Expected(const Grid& grid, int x, int y) {
+  const auto& pattern = kPatterns[static_cast<size_t>(grid.Get(x, y))];
+
+  return (pattern.hatch_spacing > 0 && 0 == (x + y) % pattern.hatch_spacing) ? pattern.hatch_color : pattern.color;
+}
+
+}  // namespace
+
+TEST_CASE("Rasterizer matches the grid", "[rasterizer]") {
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> cell(0, 3);
+  std::uniform_int_distribution<int> length(1, 80);
+  Grid grid(kWidth, kHeight);
+
+  // Runs of equal cells, so both whole words and mixed words are rendered
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth;) {
+      const auto value = static_cast<Grid::Cell>(cell(generator));
+
+      for (int end = std::min(kWidth, x + length(generator)); x < end; ++x) {
+        grid.Set(x, y, value);
+      }
+    }
+  }
+  for (size_t workers = 1; workers <= 3; ++workers) {
+    JobSystem jobs(workers);
+    Rasterizer rasterizer(kWidth, kHeight, kPatterns, jobs);
+    std::vector<SDL_Rect> spans;
+
+    grid.ForEachDirtySpan([&spans](const SDL_Rect& rc) { spans.push_back(rc); });
+    // Rectangles that do not start on a word
+    spans.back() = { 3, spans.back().y, kWidth - 3, spans.back().h };
+    rasterizer.Render(grid.row(0), grid.words_per_row(), spans);
+    for (const auto& rc : spans) {
+      for (int y = rc.y; y < rc.y + rc.h; ++y) {
+        for (int x = rc.x; x < rc.x + rc.w; ++x) {
+          REQUIRE(Expected(grid, x, y) == rasterizer.row(y)[x]);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Rasterizer benchmark", "[!benchmark]") {
+  Grid grid(800, 800);
+  JobSystem jobs;
+  Rasterizer rasterizer(800, 800, kPatterns, jobs);
+  std::vector<SDL_Rect> spans;
+
+  for (int y = 100; y < 700; ++y) {
+    for (int x = 100 + y % 64; x < 700; ++x) {
+      grid.Set(x, y, Grid::Cell::Claimed);
+    }
+  }
+  grid.ForEachDirtySpan([&spans](const SDL_Rect& rc) { spans.push_back(rc); });
+
+  BENCHMARK("Rasterize 800x800") {
+    rasterizer.Render(grid.row(0), grid.words_per_row(), spans);
+    return rasterizer.row(400)[400];
+  };
+}
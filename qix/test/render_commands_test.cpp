@@ -0,0 +1,73 @@
+#include "catch.hpp"
+#include "utility/render_queue.h"
+
+#include <thread>
+
+using namespace utility;
+
+TEST_CASE("Appended command buffers keep text and uploads", "[render_commands]") {
+  const Font font(Font::Typeface::Cabin, Font::Emphasis::Normal, 12);
+  CommandBuffer first;
+  CommandBuffer second;
+
+  first.AddText(font, 1, 2, "one", Color::White);
+  auto pixels = first.AddUpload(nullptr, { 0, 0, 2, 1 });
+  pixels[0] = 1;
+  pixels[1] = 2;
+  second.Add(0.0f, 0.0f, 1.0f, 1.0f, Color::Red);
+  second.AddText(font, 3, 4, "two", Color::Blue);
+  pixels = second.AddUpload(nullptr, { 5, 6, 1, 1 });
+  pixels[0] = 3;
+
+  first.Append(second);
+  REQUIRE(5 == first.size());
+
+  const auto& commands = first.commands();
+
+  REQUIRE(CommandBuffer::Type::Text == commands[0].type);
+  REQUIRE("one" == first.text(commands[0]));
+  REQUIRE(CommandBuffer::Type::Line == commands[2].type);
+  REQUIRE(CommandBuffer::Type::Text == commands[3].type);
+  REQUIRE("two" == first.text(commands[3]));
+  REQUIRE(3 == static_cast<int>(commands[3].x1));
+  REQUIRE(CommandBuffer::Type::Upload == commands[4].type);
+  REQUIRE(5 == first.upload(commands[4]).rc.x);
+  REQUIRE(3 == first.pixels(commands[4])[0]);
+  REQUIRE(2 == first.pixels(commands[1])[1]);
+
+  first.Clear();
+  REQUIRE(first.IsEmpty());
+}
+
+TEST_CASE("Render queue hands frames over in order", "[render_commands]") {
+  const int kFrames = 1000;
+  RenderQueue queue;
+  // Catch assertions are not thread safe, the recording thread only counts what went wrong
+  int errors = 0;
+  std::thread recorder([&queue, &errors] {
+    for (int i = 0; i < kFrames; ++i) {
+      auto frame = queue.BeginRecord();
+
+      if (nullptr == frame || !frame->IsEmpty()) {
+        errors++;
+        return;
+      }
+      frame->Add(static_cast<float>(i), 0.0f, 0.0f, 0.0f, Color::White);
+      queue.EndRecord();
+    }
+  });
+
+  for (int i = 0; i < kFrames; ++i) {
+    auto frame = queue.BeginSubmit();
+
+    REQUIRE(nullptr != frame);
+    REQUIRE(1 == frame->size());
+    REQUIRE(i == static_cast<int>(frame->commands()[0].x1));
+    queue.EndSubmit();
+  }
+  recorder.join();
+  REQUIRE(0 == errors);
+  queue.Cancel();
+  REQUIRE(nullptr == queue.BeginSubmit());
+  REQUIRE(nullptr == queue.BeginRecord());
+}
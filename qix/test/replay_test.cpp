@@ -0,0 +1,97 @@
+#include "catch.hpp"
+#include "game/replay.h"
+#include "utility/varint.h"
+
+#include <filesystem>
+
+namespace {
+
+using Controls = Playfield::Controls;
+
+const std::vector<ReplayRecord> kRecords = {
+  { 0, Controls::Start }, { 10, Controls::Up }, { 10, Controls::Left }, { 46, Controls::Left },
+  { 52, Controls::Fast }, { 100000, Controls::Pause }
+};
+const uint64_t kSeed = 1982;
+
+}  // namespace
+
+TEST_CASE("Varints round trip and stop at a cut off value", "[replay]") {
+  const std::vector<uint64_t> values = { 0, 1, 127, 128, 300, 1ull << 35, ~0ull };
+  std::vector<uint8_t> buffer;
+
+  for (auto value : values) {
+    utility::PutVarint(buffer, value);
+  }
+  size_t offset = 0;
+  uint64_t value = 0;
+
+  for (auto expected : values) {
+    REQUIRE(utility::GetVarint(buffer, offset, value));
+    REQUIRE(expected == value);
+  }
+  REQUIRE(offset == buffer.size());
+  buffer.pop_back();
+  offset = buffer.size() - 9;
+  REQUIRE(!utility::GetVarint(buffer, offset, value));
+  REQUIRE(buffer.size() - 9 == offset);
+}
+
+TEST_CASE("Replay encoding round trips and stays compact", "[replay]") {
+  std::vector<ReplayRecord> records;
+  uint64_t seed = 0;
+  const auto buffer = EncodeReplay(kRecords, kSeed);
+
+  REQUIRE(DecodeReplay(buffer, records, seed));
+  REQUIRE(records == kRecords);
+  REQUIRE(kSeed == seed);
+  // Header is magic, version, tick rate and seed, records less than eight ticks apart take a single byte
+  REQUIRE(buffer.size() == 8 + 1 + 2 + 1 + 2 + 1 + 3);
+}
+
+TEST_CASE("Replay decoding keeps what came before a cut off record", "[replay]") {
+  std::vector<ReplayRecord> records;
+  uint64_t seed = 0;
+  auto buffer = EncodeReplay(kRecords, kSeed);
+
+  buffer.pop_back();
+  REQUIRE(DecodeReplay(buffer, records, seed));
+  REQUIRE(records.size() == kRecords.size() - 1);
+  // Replays written before the seed was in the header are turned down
+  buffer[4] = 1;
+  REQUIRE(!DecodeReplay(buffer, records, seed));
+  buffer[4] = 2;
+  buffer[0] = 'X';
+  REQUIRE(!DecodeReplay(buffer, records, seed));
+  // Nor is a header cut off before the seed
+  REQUIRE(!DecodeReplay({ 'Q', 'I', 'X', 'R', 2, kLogicTicksPerSecond }, records, seed));
+}
+
+TEST_CASE("Replay recorder writes what the player plays back", "[replay]") {
+  const auto filename = (std::filesystem::temp_directory_path() / "qix_replay_test.qxr").string();
+  {
+    ReplayRecorder recorder(filename, kSeed);
+
+    for (size_t i = 0; i < kRecords.size(); ++i) {
+      recorder.Add(kRecords[i].tick, kRecords[i].control);
+      if (i % 2) {
+        recorder.Flush();
+      }
+    }
+    REQUIRE(recorder.size() == kRecords.size());
+  }
+  ReplayPlayer player(filename);
+  std::vector<Controls> played;
+
+  REQUIRE(player.records() == kRecords);
+  REQUIRE(player.seed() == kSeed);
+  REQUIRE(player.length() == 100001);
+  player.Play(10, [&played](Controls control) { played.push_back(control); });
+  REQUIRE(played == std::vector<Controls>{ Controls::Start, Controls::Up, Controls::Left });
+  player.Play(99999, [&played](Controls control) { played.push_back(control); });
+  REQUIRE(played.size() == 5);
+  REQUIRE(!player.IsDone());
+  player.Play(100000, [&played](Controls control) { played.push_back(control); });
+  REQUIRE(player.IsDone());
+  std::filesystem::remove(filename);
+}
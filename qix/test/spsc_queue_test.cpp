@@ -0,0 +1,54 @@
+#include "catch.hpp"
+#include "utility/spsc_queue.h"
+
+#include <thread>
+
+using namespace utility;
+
+TEST_CASE("SPSC queue is bounded and keeps order", "[spsc_queue]") {
+  SpscQueue<int, 4> queue;
+  int value = 0;
+
+  REQUIRE(queue.empty());
+  REQUIRE_FALSE(queue.TryPop(value));
+  for (int i = 0; i < 4; ++i) {
+    REQUIRE(queue.TryPush(i));
+  }
+  REQUIRE_FALSE(queue.TryPush(4));
+  REQUIRE(4 == queue.size());
+  REQUIRE(queue.TryPop(value));
+  REQUIRE(0 == value);
+  REQUIRE(queue.TryPush(4));
+
+  std::vector<int> drained;
+
+  REQUIRE(2 == queue.Drain([&drained](int v) { drained.push_back(v); }, 2));
+  REQUIRE(2 == queue.Drain([&drained](int v) { drained.push_back(v); }));
+  REQUIRE(std::vector<int>{ 1, 2, 3, 4 } == drained);
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("SPSC queue hands every value over between two threads", "[spsc_queue]") {
+  const int kCount = 1000000;
+  auto queue = std::make_unique<SpscQueue<int, 1024>>();
+  bool in_order = true;
+  int next = 0;
+
+  std::thread consumer([&queue, &in_order, &next]() {
+    while (next < kCount) {
+      if (0 == queue->Drain([&in_order, &next](int v) { in_order = in_order && (v == next++); })) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (int i = 0; i < kCount;) {
+    if (queue->TryPush(i)) {
+      i++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  consumer.join();
+  REQUIRE(in_order);
+  REQUIRE(kCount == next);
+}
@@ -0,0 +1,101 @@
+#include "catch.hpp"
+#include "board_fixture.h"
+#include "game/territory.h"
+#include "game/flood_fill.h"
+
+TEST_CASE("Territory areas follow the shoelace formula", "[territory]") {
+  Territory territory(kBoardWidth, kBoardHeight);
+  // Straight down from the top and back up, claims the 10 x 20 box left of the Qix
+  const std::vector<SDL_Point> stix = { { 10, 1 }, { 10, 2 }, { 10, 3 }, { 10, 4 }, { 10, 5 }, { 10, 6 }, { 10, 7 },
+                                        { 10, 8 }, { 10, 9 }, { 10, 10 }, { 10, 11 }, { 10, 12 }, { 10, 13 },
+                                        { 10, 14 }, { 10, 15 }, { 10, 16 }, { 10, 17 }, { 10, 18 }, { 10, 19 },
+                                        { 10, 20 }, { 9, 20 }, { 8, 20 }, { 7, 20 }, { 6, 20 }, { 5, 20 },
+                                        { 4, 20 }, { 3, 20 }, { 2, 20 }, { 1, 20 } };
+
+  REQUIRE(territory.total_area() == static_cast<int64_t>(kBoardWidth - 1) * (kBoardHeight - 1));
+  REQUIRE(Territory::Area(territory.unclaimed()) == territory.total_area());
+  REQUIRE(0 == territory.Claim({ 10, 0 }, stix, { 0, 20 }, { 10, 10 }));
+  REQUIRE(200 == territory.Claim({ 10, 0 }, stix, { 0, 20 }, { 100, 100 }));
+  REQUIRE(territory.claimed_area() == 200);
+  REQUIRE(territory.unclaimed().size() == 6);
+  REQUIRE(territory.IsClaimed(5, 5));
+  REQUIRE(territory.IsOnBorder(10, 5));
+  REQUIRE(territory.IsUnclaimed(11, 5));
+  REQUIRE_FALSE(territory.IsUnclaimed(5, 5));
+  REQUIRE_FALSE(territory.IsClaimed(-1, 5));
+}
+
+TEST_CASE("Territory claims match the bitmap claims", "[territory]") {
+  Grid grid(kBoardWidth, kBoardHeight);
+  FloodFill flood_fill(kBoardWidth, kBoardHeight);
+  Territory territory(kBoardWidth, kBoardHeight);
+  std::mt19937 rng(1981);
+  std::vector<SDL_Point> stix;
+  SDL_Point start;
+  SDL_Point end;
+  int claims = 0;
+
+  for (int i = 0; i < 1500; ++i) {
+    // A new game every now and then, the board fills up quickly
+    if (0 == i % 150) {
+      grid.Reset();
+      territory.Reset();
+    }
+    // Clear of other edges, a stix right next to one splits the unclaimed cells but not the area
+    if (!DrawBox(grid, rng, start, stix, end, true)) {
+      continue;
+    }
+    for (const auto& pt : stix) {
+      grid.Set(pt.x, pt.y, Grid::Cell::Edge);
+    }
+    const auto qix = PlaceQix(grid, rng);
+
+    if (0 == flood_fill.Claim(grid, qix.x, qix.y)) {
+      // The stix is an edge now, the vector territory only knows edges around claims
+      grid.Reset();
+      territory.Reset();
+      continue;
+    }
+    REQUIRE(territory.Claim(start, stix, end, qix) > 0);
+    claims++;
+
+    const auto& polygon = territory.unclaimed();
+    int64_t unclaimed = 0;
+    int64_t perimeter = 0;
+    int mismatches = 0;
+
+    for (int y = 0; y < kBoardHeight; ++y) {
+      for (int x = 0; x < kBoardWidth; ++x) {
+        const auto cell = grid.Get(x, y);
+
+        mismatches += ((Grid::Cell::Unclaimed == cell) != territory.IsUnclaimed(x, y)) ? 1 : 0;
+        mismatches += ((Grid::Cell::Claimed == cell) != territory.IsClaimed(x, y)) ? 1 : 0;
+        unclaimed += (Grid::Cell::Unclaimed == cell) ? 1 : 0;
+      }
+    }
+    REQUIRE(0 == mismatches);
+    for (size_t v = 0; v < polygon.size(); ++v) {
+      const auto& a = polygon[v];
+      const auto& b = polygon[(v + 1) % polygon.size()];
+
+      perimeter += std::abs(a.x - b.x) + std::abs(a.y - b.y);
+    }
+    // Pick's theorem, the area is the cells inside plus half the cells on the border less one
+    REQUIRE(Territory::Area(polygon) == unclaimed + perimeter / 2 - 1);
+    REQUIRE(territory.claimed_area() + Territory::Area(polygon) == territory.total_area());
+  }
+  REQUIRE(claims > 50);
+}
+
+TEST_CASE("Territory does not depend on the size of the field", "[territory]") {
+  const int size = 1 << 30;
+  Territory territory(size, size);
+  const int x = size / 2;
+  // Straight across the field
+  const std::vector<SDL_Point> stix = { { x, 1 }, { x, size - 2 } };
+
+  REQUIRE(territory.Claim({ x, 0 }, stix, { x, size - 1 }, { 1, 1 }) == static_cast<int64_t>(size - 1 - x) * (size - 1));
+  REQUIRE(territory.IsClaimed(size - 2, size / 3));
+  REQUIRE(territory.IsUnclaimed(1, size / 3));
+  REQUIRE(territory.Percentage() < 50.0);
+}
@@ -0,0 +1,42 @@
+#include "catch.hpp"
+#include "utility/xoshiro.h"
+
+#include <array>
+#include <cstdint>
+
+TEST_CASE("Xoshiro replays its seed", "[xoshiro]") {
+  utility::Xoshiro256 a(7);
+  utility::Xoshiro256 b(7);
+  utility::Xoshiro256 c(8);
+  bool differs = false;
+
+  for (int i = 0; i < 1000; ++i) {
+    const auto value = a();
+
+    REQUIRE(value == b());
+    differs = differs || value != c();
+
+    const float uniform = a.Uniform(-2.0f, 3.0f);
+
+    REQUIRE(uniform >= -2.0f);
+    REQUIRE(uniform < 3.0f);
+    b.Uniform(-2.0f, 3.0f);
+    c.Uniform(-2.0f, 3.0f);
+  }
+  REQUIRE(differs);
+
+  // Both ends of an integer range come up, nothing outside it
+  std::array<int, 5> counts = {};
+
+  for (int i = 0; i < 5000; ++i) {
+    const int value = a.UniformInt(-2, 2);
+
+    REQUIRE(value >= -2);
+    REQUIRE(value <= 2);
+    counts[value + 2]++;
+  }
+  for (auto count : counts) {
+    REQUIRE(count > 800);
+  }
+  REQUIRE(INT32_MIN == utility::Xoshiro256(0).UniformInt(INT32_MIN, INT32_MIN));
+}